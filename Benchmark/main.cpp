@@ -0,0 +1,137 @@
+// Measures the time per node spent generating moves.
+//
+// usage: chess_benchmark [--iterations=N] [fen ...]
+//
+// Each position is a node. The moves of each node are generated repeatedly by each method and the average time per
+// node is reported for each.
+
+#include "Chess/Board.h"
+#include "Chess/GameState.h"
+#include "Chess/MoveGenerator.h"
+#include "Chess/MoveList.h"
+#include "Chess/Piece.h"
+#include "Chess/PieceMoves.h"
+#include "Chess/Position.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static constexpr char   OPTION_ITERATIONS_KEY[]      = "--iterations=";
+static constexpr size_t OPTION_ITERATIONS_KEY_LENGTH = sizeof(OPTION_ITERATIONS_KEY) - 1;
+
+static char const * const DEFAULT_FENS[] =
+{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+
+// Generates the moves by looking at every square and calling the virtual generator of the piece on it
+static void generateVirtual(GameState const & state, MoveList & moves)
+{
+    for (int r = 0; r < Board::SIZE; ++r)
+    {
+        for (int c = 0; c < Board::SIZE; ++c)
+        {
+            Piece const * piece = state.board_.pieceAt(r, c);
+            if (piece && piece->color() == state.whoseTurn_)
+                piece->generatePossibleMoves(state, Position(r, c), moves);
+        }
+    }
+}
+
+static void generateTemplated(GameState const & state, MoveList & moves)
+{
+    PieceMoves::generatePossibleMoves(state, moves);
+}
+
+static void generateLegal(GameState const & state, MoveList & moves)
+{
+    MoveGenerator::generateLegalMoves(state, moves);
+}
+
+// Returns the average time per node in nanoseconds
+template <typename Generator>
+static double measure(std::vector<GameState> const & states, int iterations, Generator generate, size_t & total)
+{
+    auto start = std::chrono::steady_clock::now();
+    total = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        for (auto const & state : states)
+        {
+            MoveList moves;
+            generate(state, moves);
+            total += moves.size();
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double(iterations) * double(states.size()));
+}
+
+int main(int argc, char ** argv)
+{
+    int                    iterations = 100000;
+    std::vector<GameState> states;
+
+    --argc;
+    ++argv;
+    while (argc > 0)
+    {
+        if (strncmp(*argv, OPTION_ITERATIONS_KEY, OPTION_ITERATIONS_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_ITERATIONS_KEY_LENGTH, "%d", &iterations);
+        }
+        else
+        {
+            GameState state;
+            if (!state.initializeFromFen(*argv))
+            {
+                fprintf(stderr, "Unable to parse input: %s\n", *argv);
+                return 1;
+            }
+            states.push_back(state);
+        }
+        --argc;
+        ++argv;
+    }
+
+    if (states.empty())
+    {
+        for (auto fen : DEFAULT_FENS)
+        {
+            GameState state;
+            state.initializeFromFen(fen);
+            states.push_back(state);
+        }
+    }
+
+    struct Method
+    {
+        char const * name;
+        void (*generate)(GameState const &, MoveList &);
+    };
+    Method const methods[] =
+    {
+        { "virtual",   generateVirtual },
+        { "templated", generateTemplated },
+        { "legal",     generateLegal },
+    };
+
+    printf("%-10s %12s %12s\n", "method", "ns/node", "moves");
+    double baseline = 0.0;
+    for (auto const & m : methods)
+    {
+        size_t total;
+        double ns = measure(states, iterations, m.generate, total);
+        if (baseline == 0.0)
+            baseline = ns;
+        printf("%-10s %12.1f %12zu  (%.2fx)\n", m.name, ns, total / iterations, baseline / ns);
+    }
+    return 0;
+}
@@ -18,6 +18,17 @@
 
 #include <cassert>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define BITBOARD_PEXT_AVAILABLE 1
+#define BITBOARD_AVX2_AVAILABLE 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 namespace
 {
 
@@ -260,8 +271,492 @@ uint64_t const s_destinations[BitBoard::NUMBER_OF_PIECES][BitBoard::SIZE] =
     }
 };
 
-uint64_t s_blockedRowsAndColumns[BitBoard::SIZE][BitBoard::SIZE];   //! BUG: Uninitialized
-uint64_t s_blockedDiagonals[BitBoard::SIZE][BitBoard::SIZE];        //! BUG: Uninitialized
+// Squares attacked by a pawn of each color (computed at startup)
+uint64_t s_pawnThreatened[2][BitBoard::SIZE];
+
+// Destinations of a pawn of each color on an empty board (computed at startup)
+uint64_t s_pawnDestinations[2][BitBoard::SIZE];
+
+// Squares hidden from the first square by a piece on the second square, if they share a row or column (computed at startup)
+uint64_t s_blockedRowsAndColumns[BitBoard::SIZE][BitBoard::SIZE];
+
+// Squares hidden from the first square by a piece on the second square, if they share a diagonal (computed at startup)
+uint64_t s_blockedDiagonals[BitBoard::SIZE][BitBoard::SIZE];
+
+// Squares strictly between two squares sharing a row, column, or diagonal (computed at startup)
+uint64_t s_between[BitBoard::SIZE][BitBoard::SIZE];
+
+// Magic multipliers for rook attack lookups. These were found by testing sparse random numbers against every possible
+// arrangement of blockers. Any change to the relevant masks or the square numbering invalidates them.
+uint64_t const s_rookMagics[BitBoard::SIZE] =
+{
+    0x8080102040008000, 0x5440041000200048, 0x008020008010000a, 0x0200084200100420,
+    0x0200081020040200, 0x0600019002002824, 0x040050811008020c, 0x0100004881000126,
+    0x0005800440008020, 0x2882002042090880, 0x0002802000801004, 0x0240808010000800,
+    0x4480800800040082, 0x0408808004000200, 0x00ba0004a8020001, 0x1106000042040091,
+    0x0020208010400080, 0x0022060045028020, 0x0020008020100080, 0x0202020008102041,
+    0x0c50808008000400, 0x0068808002000400, 0x00510400c8100201, 0x400006000100a444,
+    0x483424818008400a, 0x8840008080200040, 0x0800100080802000, 0x0440100080800800,
+    0x4000080080040080, 0x9124040080020080, 0x0089000300040e00, 0x080001020020488c,
+    0x9040002040800080, 0x80d0002001400242, 0x0000401901002002, 0x0030220901001000,
+    0x0080580005003100, 0x0022006c0a001008, 0x0802301144001248, 0x0020010042000084,
+    0x4ac0400084228004, 0x0010004020004000, 0x3110004020010100, 0x0598100009050020,
+    0x4200080011010004, 0x0818020004008080, 0x02a0708102040008, 0x5201010080420004,
+    0x100b124063800100, 0x7808200240048980, 0x8800200010008080, 0x1099201001000900,
+    0x0100050010080100, 0x0400800200040080, 0x2040280190020400, 0x00100c0100608200,
+    0x0000201241088202, 0x1040002042801b01, 0x0124090010200041, 0x0831002004081001,
+    0x2003000800021005, 0x80010002040008c1, 0x0208008122081004, 0x4000008844002102
+};
+
+// Magic multipliers for bishop attack lookups (see s_rookMagics)
+uint64_t const s_bishopMagics[BitBoard::SIZE] =
+{
+    0x0020011019010028, 0x0122100912208000, 0x1498082308200080, 0x0004106600000000,
+    0x2082021000405600, 0x68508804c0820201, 0xa004140422080010, 0x0120402084202004,
+    0x0000f0101014c080, 0x014002300a022041, 0x000084080a004020, 0x2061949202010083,
+    0x0407820210050008, 0x00500101084008a2, 0x2000040404420880, 0x00090044041c0710,
+    0x0804004030841140, 0x002580a001240100, 0x2081000214090200, 0x0812022c01220050,
+    0x0602001012100010, 0x0003004080454024, 0x0000400088084800, 0x8000800040480850,
+    0x1010040110602230, 0x8428204002044d32, 0x0340240028880200, 0x1804080018220040,
+    0x0c10101041004001, 0x0422208008080100, 0x0010810610941000, 0x0302122002050140,
+    0x8304104008054400, 0x1000ac5003a45026, 0x0202402080100508, 0xc801042008040100,
+    0x00400020210a0080, 0x4010404200004104, 0x0401180120008c00, 0x0811450200110052,
+    0xb10110825000a020, 0x8104008405001050, 0x0908094050030803, 0x000414c204800804,
+    0x2000202414004042, 0x044001040020a100, 0x0008100400440082, 0x210101050a040102,
+    0x8004442420080000, 0x0906008421080000, 0x0220208048081004, 0x0000004084240800,
+    0x00080020a0864200, 0x40010484880e0000, 0x9040100440808008, 0x0010028089020002,
+    0x100082004202c000, 0x4049051042022000, 0x010100010c110400, 0x8200000b02208810,
+    0x0000001008210100, 0x0000180410241840, 0x0880100401680a01, 0x04021a0809040081
+};
+
+// Lookup data for the attacks of one type of sliding piece from one square
+struct MagicEntry
+{
+    uint64_t   mask;    // Squares whose occupancy can block the piece (the rays, excluding the edges of the board)
+    uint64_t   magic;   // Multiplier that maps each arrangement of blockers to a unique index
+    int        shift;   // 64 - the number of bits in the mask
+    uint64_t * attacks; // Attacked squares for each arrangement of blockers, indexed by the magic hash
+    uint64_t * pextAttacks; // Attacked squares for each arrangement of blockers, indexed by PEXT of the blockers
+};
+
+int constexpr ROOK_ATTACK_TABLE_SIZE   = 102400; // Sum of 2^(number of relevant squares) for all squares
+int constexpr BISHOP_ATTACK_TABLE_SIZE = 5248;   // Sum of 2^(number of relevant squares) for all squares
+
+MagicEntry s_rookMagicEntries[BitBoard::SIZE];
+MagicEntry s_bishopMagicEntries[BitBoard::SIZE];
+uint64_t   s_rookAttacks[ROOK_ATTACK_TABLE_SIZE];
+uint64_t   s_bishopAttacks[BISHOP_ATTACK_TABLE_SIZE];
+uint64_t   s_rookPextAttacks[ROOK_ATTACK_TABLE_SIZE];
+uint64_t   s_bishopPextAttacks[BISHOP_ATTACK_TABLE_SIZE];
+
+// True if the CPU has a fast PEXT instruction (determined at startup)
+bool s_pextSupported = false;
+
+// The backend used by threatened() and destinations(). It is chosen at startup according to the CPU.
+BitBoard::SlidingAttackBackend s_backend = BitBoard::MAGIC;
+
+// True if the CPU (and the OS) support AVX2 (determined at startup)
+bool s_avx2Supported = false;
+
+// The backend used by slidingAttacksFill(). It is chosen at startup according to the CPU.
+BitBoard::FillBackend s_fillBackend = BitBoard::SCALAR;
+
+// Columns excluded from the result of a shift in each direction, so that pieces do not wrap around the edges
+uint64_t constexpr NOT_COLUMN_A = ~0x0101010101010101ULL;
+uint64_t constexpr NOT_COLUMN_H = ~0x8080808080808080ULL;
+uint64_t constexpr ANY_COLUMN   = ~0ULL;
+
+// Fills from the pieces in one direction (a positive shift moves toward higher indexes), stopping at (and including)
+// the first occupied square. The pieces' own squares are not included.
+inline uint64_t fill(uint64_t pieces, uint64_t empty, int shift, uint64_t wrap)
+{
+    empty &= wrap;
+    if (shift > 0)
+    {
+        pieces |= empty & (pieces << shift);
+        empty  &= empty << shift;
+        pieces |= empty & (pieces << (2 * shift));
+        empty  &= empty << (2 * shift);
+        pieces |= empty & (pieces << (4 * shift));
+        return (pieces << shift) & wrap;
+    }
+    else
+    {
+        shift = -shift;
+        pieces |= empty & (pieces >> shift);
+        empty  &= empty >> shift;
+        pieces |= empty & (pieces >> (2 * shift));
+        empty  &= empty >> (2 * shift);
+        pieces |= empty & (pieces >> (4 * shift));
+        return (pieces >> shift) & wrap;
+    }
+}
+
+// Returns the squares attacked by the sliding pieces, filling the 8 directions one at a time
+uint64_t scalarFill(uint64_t orthogonal, uint64_t diagonal, uint64_t occupied)
+{
+    uint64_t empty = ~occupied;
+    return fill(orthogonal, empty, 1, NOT_COLUMN_A) |
+           fill(orthogonal, empty, -1, NOT_COLUMN_H) |
+           fill(orthogonal, empty, 8, ANY_COLUMN) |
+           fill(orthogonal, empty, -8, ANY_COLUMN) |
+           fill(diagonal, empty, 9, NOT_COLUMN_A) |
+           fill(diagonal, empty, 7, NOT_COLUMN_H) |
+           fill(diagonal, empty, -7, NOT_COLUMN_A) |
+           fill(diagonal, empty, -9, NOT_COLUMN_H);
+}
+
+// Returns the squares attacked by a sliding piece by masking out the squares hidden by each blocker, one at a time
+uint64_t loopAttacks(int type, int from, uint64_t blockers)
+{
+    uint64_t rv = s_threatened[type][from];
+
+    switch (type)
+    {
+    case BitBoard::QUEEN:
+        for (int i = 0; i < BitBoard::SIZE; ++i)
+        {
+            if (blockers & 1)
+            {
+                rv &= ~s_blockedRowsAndColumns[from][i];
+                rv &= ~s_blockedDiagonals[from][i];
+            }
+            blockers >>= 1;
+        }
+        break;
+    case BitBoard::ROOK:
+        for (int i = 0; i < BitBoard::SIZE; ++i)
+        {
+            if (blockers & 1)
+                rv &= ~s_blockedRowsAndColumns[from][i];
+            blockers >>= 1;
+        }
+        break;
+    case BitBoard::BISHOP:
+        for (int i = 0; i < BitBoard::SIZE; ++i)
+        {
+            if (blockers & 1)
+                rv &= ~s_blockedDiagonals[from][i];
+            blockers >>= 1;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return rv;
+}
+
+// Returns the squares attacked by a rook or bishop using a magic lookup
+inline uint64_t magicAttacks(MagicEntry const & entry, uint64_t blockers)
+{
+    return entry.attacks[((blockers & entry.mask) * entry.magic) >> entry.shift];
+}
+
+// Returns the squares attacked by a sliding piece using a magic lookup
+uint64_t magicAttacks(int type, int from, uint64_t blockers)
+{
+    switch (type)
+    {
+    case BitBoard::QUEEN:
+        return magicAttacks(s_rookMagicEntries[from], blockers) | magicAttacks(s_bishopMagicEntries[from], blockers);
+    case BitBoard::ROOK:
+        return magicAttacks(s_rookMagicEntries[from], blockers);
+    case BitBoard::BISHOP:
+        return magicAttacks(s_bishopMagicEntries[from], blockers);
+    default:
+        return s_threatened[type][from];
+    }
+}
+
+#if defined(BITBOARD_PEXT_AVAILABLE)
+
+// Returns true if the CPU has a fast PEXT instruction
+bool cpuHasFastPext()
+{
+    unsigned info[4] = { 0 };
+
+#if defined(_MSC_VER)
+    __cpuidex((int *)info, 0, 0);
+#else
+    __cpuid_count(0, 0, info[0], info[1], info[2], info[3]);
+#endif
+    unsigned maxLeaf = info[0];
+    bool     isAmd   = info[1] == 0x68747541; // "Auth" (from "AuthenticAMD")
+    if (maxLeaf < 7)
+        return false;
+
+#if defined(_MSC_VER)
+    __cpuidex((int *)info, 1, 0);
+#else
+    __cpuid_count(1, 0, info[0], info[1], info[2], info[3]);
+#endif
+    unsigned family = ((info[0] >> 8) & 0xf) + ((info[0] >> 20) & 0xff);
+
+#if defined(_MSC_VER)
+    __cpuidex((int *)info, 7, 0);
+#else
+    __cpuid_count(7, 0, info[0], info[1], info[2], info[3]);
+#endif
+    bool hasBmi2 = (info[1] & (1 << 8)) != 0;
+
+    // AMD processors before Zen 3 (family 19h) implement PEXT in microcode, which is slower than a magic lookup
+    return hasBmi2 && !(isAmd && family < 0x19);
+}
+
+// Returns the squares attacked by a rook or bishop using a PEXT lookup
+#if defined(__GNUC__)
+__attribute__((target("bmi2")))
+#endif
+inline uint64_t pextAttacks(MagicEntry const & entry, uint64_t blockers)
+{
+    return entry.pextAttacks[_pext_u64(blockers, entry.mask)];
+}
+
+// Returns the squares attacked by a sliding piece using a PEXT lookup
+#if defined(__GNUC__)
+__attribute__((target("bmi2")))
+#endif
+uint64_t pextAttacks(int type, int from, uint64_t blockers)
+{
+    switch (type)
+    {
+    case BitBoard::QUEEN:
+        return pextAttacks(s_rookMagicEntries[from], blockers) | pextAttacks(s_bishopMagicEntries[from], blockers);
+    case BitBoard::ROOK:
+        return pextAttacks(s_rookMagicEntries[from], blockers);
+    case BitBoard::BISHOP:
+        return pextAttacks(s_bishopMagicEntries[from], blockers);
+    default:
+        return s_threatened[type][from];
+    }
+}
+
+#else // defined(BITBOARD_PEXT_AVAILABLE)
+
+bool cpuHasFastPext()
+{
+    return false;
+}
+
+#endif // defined(BITBOARD_PEXT_AVAILABLE)
+
+#if defined(BITBOARD_AVX2_AVAILABLE)
+
+// Returns true if the CPU and the OS support AVX2
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+// Returns the squares attacked by the sliding pieces, filling 4 directions at a time. The lanes of one register fill
+// the directions toward higher indexes and the lanes of the other fill the directions toward lower indexes.
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+#endif
+uint64_t avx2Fill(uint64_t orthogonal, uint64_t diagonal, uint64_t occupied)
+{
+    // Lanes: east/west, south/north, southwest/northeast, southeast/northwest
+    __m256i const shifts   = _mm256_setr_epi64x(1, 8, 7, 9);
+    __m256i const shifts2  = _mm256_slli_epi64(shifts, 1);
+    __m256i const shifts4  = _mm256_slli_epi64(shifts, 2);
+    __m256i const wrapUp   = _mm256_setr_epi64x((long long)NOT_COLUMN_A, (long long)ANY_COLUMN,
+                                                (long long)NOT_COLUMN_H, (long long)NOT_COLUMN_A);
+    __m256i const wrapDown = _mm256_setr_epi64x((long long)NOT_COLUMN_H, (long long)ANY_COLUMN,
+                                                (long long)NOT_COLUMN_A, (long long)NOT_COLUMN_H);
+
+    __m256i pieces = _mm256_setr_epi64x((long long)orthogonal, (long long)orthogonal, (long long)diagonal, (long long)diagonal);
+    __m256i empty  = _mm256_set1_epi64x((long long)~occupied);
+
+    // Toward higher indexes
+    __m256i g = pieces;
+    __m256i p = _mm256_and_si256(empty, wrapUp);
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_sllv_epi64(g, shifts)));
+    p = _mm256_and_si256(p, _mm256_sllv_epi64(p, shifts));
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_sllv_epi64(g, shifts2)));
+    p = _mm256_and_si256(p, _mm256_sllv_epi64(p, shifts2));
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_sllv_epi64(g, shifts4)));
+    __m256i up = _mm256_and_si256(_mm256_sllv_epi64(g, shifts), wrapUp);
+
+    // Toward lower indexes
+    g = pieces;
+    p = _mm256_and_si256(empty, wrapDown);
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_srlv_epi64(g, shifts)));
+    p = _mm256_and_si256(p, _mm256_srlv_epi64(p, shifts));
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_srlv_epi64(g, shifts2)));
+    p = _mm256_and_si256(p, _mm256_srlv_epi64(p, shifts2));
+    g = _mm256_or_si256(g, _mm256_and_si256(p, _mm256_srlv_epi64(g, shifts4)));
+    __m256i down = _mm256_and_si256(_mm256_srlv_epi64(g, shifts), wrapDown);
+
+    // Combine the 8 directions
+    __m256i all  = _mm256_or_si256(up, down);
+    __m128i half = _mm_or_si128(_mm256_castsi256_si128(all), _mm256_extracti128_si256(all, 1));
+    return uint64_t(_mm_cvtsi128_si64(half)) | uint64_t(_mm_extract_epi64(half, 1));
+}
+
+#else // defined(BITBOARD_AVX2_AVAILABLE)
+
+bool cpuHasAvx2()
+{
+    return false;
+}
+
+#endif // defined(BITBOARD_AVX2_AVAILABLE)
+
+// Returns the squares attacked by a sliding piece using the specified backend
+inline uint64_t slidingAttacks(BitBoard::SlidingAttackBackend backend, int type, int from, uint64_t blockers)
+{
+    switch (backend)
+    {
+    case BitBoard::LOOP:
+        return loopAttacks(type, from, blockers);
+#if defined(BITBOARD_PEXT_AVAILABLE)
+    case BitBoard::PEXT:
+        return pextAttacks(type, from, blockers);
+#endif
+    case BitBoard::MAGIC:
+    default:
+        return magicAttacks(type, from, blockers);
+    }
+}
+
+// Initializes the lookup data for one type of sliding piece. Returns the number of table entries used.
+int initializeSlidingAttacks(int type, uint64_t const * magics, MagicEntry * entries, uint64_t * attacks, uint64_t * pextAttacks)
+{
+    uint64_t const * blockedTable = (type == BitBoard::ROOK) ? &s_blockedRowsAndColumns[0][0] : &s_blockedDiagonals[0][0];
+    int              used         = 0;
+
+    for (int from = 0; from < BitBoard::SIZE; ++from)
+    {
+        // The relevant squares are the attacked squares that can hide other squares (i.e. excluding the edges)
+        uint64_t mask = 0;
+        for (int i = 0; i < BitBoard::SIZE; ++i)
+        {
+            if (blockedTable[from * BitBoard::SIZE + i] != 0)
+                mask |= (uint64_t)1 << i;
+        }
+
+        int bits = 0;
+        for (uint64_t m = mask; m != 0; m &= m - 1)
+            ++bits;
+
+        MagicEntry & entry = entries[from];
+        entry.mask    = mask;
+        entry.magic   = magics[from];
+        entry.shift   = 64 - bits;
+        entry.attacks = attacks + used;
+        entry.pextAttacks = pextAttacks + used;
+
+        // Enumerate every subset of the relevant squares and store its attacks. Note that the subsets are enumerated in
+        // the order of their PEXT values.
+        uint64_t blockers = 0;
+        int      i        = 0;
+        do
+        {
+            uint64_t a = loopAttacks(type, from, blockers);
+            entry.attacks[(blockers * entry.magic) >> entry.shift] = a;
+            entry.pextAttacks[i++] = a;
+            blockers = (blockers - mask) & mask;
+        }
+        while (blockers != 0);
+
+        used += 1 << bits;
+    }
+
+    return used;
+}
+
+// Computes the tables that are not precomputed
+struct TableInitializer
+{
+    TableInitializer()
+    {
+        for (int from = 0; from < BitBoard::SIZE; ++from)
+        {
+            int r0 = from / BitBoard::SQUARES_PER_ROW;
+            int c0 = from % BitBoard::SQUARES_PER_ROW;
+
+            // Walk each of the 8 rays, accumulating the squares passed over along the way
+            for (int dr = -1; dr <= 1; ++dr)
+            {
+                for (int dc = -1; dc <= 1; ++dc)
+                {
+                    if (dr == 0 && dc == 0)
+                        continue;
+
+                    uint64_t (&blocked)[BitBoard::SIZE] = (dr == 0 || dc == 0) ? s_blockedRowsAndColumns[from]
+                                                                               : s_blockedDiagonals[from];
+                    uint64_t span = 0;
+                    int      ray[BitBoard::SQUARES_PER_ROW];
+                    int      length = 0;
+                    for (int r = r0 + dr, c = c0 + dc;
+                         r >= 0 && r < BitBoard::SQUARES_PER_COLUMN && c >= 0 && c < BitBoard::SQUARES_PER_ROW;
+                         r += dr, c += dc)
+                    {
+                        int to = r * BitBoard::SQUARES_PER_ROW + c;
+                        s_between[from][to] = span;
+                        span |= (uint64_t)1 << to;
+
+                        // This square is hidden by a piece on any of the squares before it in the ray
+                        for (int i = 0; i < length; ++i)
+                            blocked[ray[i]] |= (uint64_t)1 << to;
+                        ray[length++] = to;
+                    }
+                }
+            }
+        }
+
+        // The pawn tables of both colors are computed with the set-wise functions. Unlike the pawn rows of
+        // s_threatened[], they include the first and last rows, so they can also be used to find the pawns that attack
+        // a square.
+        for (int color : { BitBoard::WHITE, BitBoard::BLACK })
+        {
+            BitBoard::PawnColor pawnColor = (BitBoard::PawnColor)color;
+            for (int i = 0; i < BitBoard::SIZE; ++i)
+            {
+                BitBoard pawn((uint64_t)1 << i);
+                BitBoard none;
+                s_pawnThreatened[color][i]   = BitBoard::pawnAttacks(pawnColor, pawn);
+                s_pawnDestinations[color][i] = uint64_t(BitBoard::pawnPushes(pawnColor, pawn, none)) |
+                                               uint64_t(BitBoard::pawnDoublePushes(pawnColor, pawn, none));
+            }
+        }
+
+        int rookEntries = initializeSlidingAttacks(BitBoard::ROOK,
+                                                   s_rookMagics,
+                                                   s_rookMagicEntries,
+                                                   s_rookAttacks,
+                                                   s_rookPextAttacks);
+        int bishopEntries = initializeSlidingAttacks(BitBoard::BISHOP,
+                                                     s_bishopMagics,
+                                                     s_bishopMagicEntries,
+                                                     s_bishopAttacks,
+                                                     s_bishopPextAttacks);
+        assert(rookEntries == ROOK_ATTACK_TABLE_SIZE);
+        assert(bishopEntries == BISHOP_ATTACK_TABLE_SIZE);
+        (void)rookEntries;
+        (void)bishopEntries;
+
+        // Choose the fastest backend supported by this CPU
+        s_pextSupported = cpuHasFastPext();
+        s_backend       = s_pextSupported ? BitBoard::PEXT : BitBoard::MAGIC;
+        s_avx2Supported = cpuHasAvx2();
+        s_fillBackend   = s_avx2Supported ? BitBoard::AVX2 : BitBoard::SCALAR;
+    }
+};
+
+TableInitializer const s_tableInitializer;
 } // anonymous namespace
 
 void BitBoard::flip()
@@ -291,12 +786,18 @@ unsigned BitBoard::column(int c) const
 
 BitBoard BitBoard::threatened(int type, int r, int c)
 {
-    assert(type >= KING && type <= PAWN);
     assert(r >= 0 && r < SQUARES_PER_ROW);
     assert(c >= 0 && c < SQUARES_PER_COLUMN);
 
-    int from = index(r, c);
-    return BitBoard(s_threatened[type][from]);
+    return threatened(type, index(r, c));
+}
+
+BitBoard BitBoard::threatened(int type, int i)
+{
+    assert(type >= KING && type <= PAWN);
+    assert(i >= 0 && i < SIZE);
+
+    return BitBoard(s_threatened[type][i]);
 }
 
 BitBoard BitBoard::threatened(int type, int r, int c, const BitBoard& friends, const BitBoard& foes)
@@ -307,44 +808,9 @@ BitBoard BitBoard::threatened(int type, int r, int c, const BitBoard& friends, c
 
     int from = index(r, c);
 
-    // First get the uninhibited movement
-    uint64_t rv = s_threatened[type][from];
-
-    // Remove blocked squares (for certain pieces)
+    // Get the movement, excluding blocked squares (for sliding pieces)
     uint64_t blockers = uint64_t(friends) | uint64_t(foes);
-
-    switch (type)
-    {
-    case QUEEN:
-        for (int i = 0; i < SIZE; ++i)
-        {
-            if (blockers & 1)
-            {
-                rv &= ~s_blockedRowsAndColumns[from][i];
-                rv &= ~s_blockedDiagonals[from][i];
-            }
-            blockers >>= 1;
-        }
-        break;
-    case ROOK:
-        for (int i = 0; i < SIZE; ++i)
-        {
-            if (blockers & 1)
-                rv &= ~s_blockedRowsAndColumns[from][i];
-            blockers >>= 1;
-        }
-        break;
-    case BISHOP:
-        for (int i = 0; i < SIZE; ++i)
-        {
-            if (blockers & 1)
-                rv &= ~s_blockedDiagonals[from][i];
-            blockers >>= 1;
-        }
-        break;
-    default:
-        break;
-    }
+    uint64_t rv       = ::slidingAttacks(s_backend, type, from, blockers);
 
     // Remove squares occupied by friends
     rv &= ~uint64_t(friends);
@@ -371,44 +837,25 @@ BitBoard BitBoard::destinations(int type, int r, int c, const BitBoard& friends,
 
     int from = index(r, c);
 
-    // First get the uninhibited movement
-    uint64_t rv =  s_destinations[type][from];
-
     // Remove blocked squares (for certain pieces)
     uint64_t blockers = uint64_t(friends) | uint64_t(foes);
+    uint64_t rv;
 
-    switch (type)
+    if (type == PAWN)
     {
-    case QUEEN:
-        for (int i = 0; i < SIZE; ++i)
-        {
-            if (blockers & 1)
-            {
-                rv &= ~s_blockedRowsAndColumns[from][i];
-                rv &= ~s_blockedDiagonals[from][i];
-            }
-            blockers >>= 1;
-        }
-        break;
-    case ROOK:
-    case PAWN:
+        // First get the uninhibited movement
+        rv = s_destinations[type][from];
+
         for (int i = 0; i < SIZE; ++i)
         {
             if (blockers & 1)
                 rv &= ~s_blockedRowsAndColumns[from][i];
             blockers >>= 1;
         }
-        break;
-    case BISHOP:
-        for (int i = 0; i < SIZE; ++i)
-        {
-            if (blockers & 1)
-                rv &= ~s_blockedDiagonals[from][i];
-            blockers >>= 1;
-        }
-        break;
-    default:
-        break;
+    }
+    else
+    {
+        rv = ::slidingAttacks(s_backend, type, from, blockers);
     }
 
     // Remove squares occupied by friends
@@ -416,3 +863,157 @@ BitBoard BitBoard::destinations(int type, int r, int c, const BitBoard& friends,
 
     return BitBoard(rv);
 }
+
+BitBoard BitBoard::pawnThreatened(PawnColor color, int i)
+{
+    assert(color == WHITE || color == BLACK);
+    assert(i >= 0 && i < SIZE);
+
+    return BitBoard(s_pawnThreatened[color][i]);
+}
+
+BitBoard BitBoard::pawnDestinations(PawnColor color, int i)
+{
+    assert(color == WHITE || color == BLACK);
+    assert(i >= 0 && i < SIZE);
+
+    return BitBoard(s_pawnDestinations[color][i]);
+}
+
+BitBoard BitBoard::slidingAttacks(int type, int r, int c, const BitBoard& occupied)
+{
+    assert(type == QUEEN || type == ROOK || type == BISHOP);
+    assert(r >= 0 && r < SQUARES_PER_ROW);
+    assert(c >= 0 && c < SQUARES_PER_COLUMN);
+
+    return BitBoard(::slidingAttacks(s_backend, type, index(r, c), uint64_t(occupied)));
+}
+
+BitBoard BitBoard::slidingAttacks(int type, int i, const BitBoard& occupied)
+{
+    assert(type == QUEEN || type == ROOK || type == BISHOP);
+    assert(i >= 0 && i < SIZE);
+
+    return BitBoard(::slidingAttacks(s_backend, type, i, uint64_t(occupied)));
+}
+
+BitBoard BitBoard::slidingAttacks(int type, int r, int c, const BitBoard& occupied, SlidingAttackBackend backend)
+{
+    assert(type == QUEEN || type == ROOK || type == BISHOP);
+    assert(r >= 0 && r < SQUARES_PER_ROW);
+    assert(c >= 0 && c < SQUARES_PER_COLUMN);
+    assert(isSupported(backend));
+
+    return BitBoard(::slidingAttacks(backend, type, index(r, c), uint64_t(occupied)));
+}
+
+BitBoard::SlidingAttackBackend BitBoard::slidingAttackBackend()
+{
+    return s_backend;
+}
+
+bool BitBoard::setSlidingAttackBackend(SlidingAttackBackend backend)
+{
+    if (!isSupported(backend))
+        return false;
+    s_backend = backend;
+    return true;
+}
+
+bool BitBoard::isSupported(SlidingAttackBackend backend)
+{
+    switch (backend)
+    {
+    case LOOP:
+    case MAGIC:
+        return true;
+    case PEXT:
+        return s_pextSupported;
+    default:
+        return false;
+    }
+}
+
+char const * BitBoard::name(SlidingAttackBackend backend)
+{
+    switch (backend)
+    {
+    case LOOP:  return "loop";
+    case MAGIC: return "magic";
+    case PEXT:  return "pext";
+    default:    return "unknown";
+    }
+}
+
+BitBoard BitBoard::slidingAttacksFill(const BitBoard& orthogonal, const BitBoard& diagonal, const BitBoard& occupied)
+{
+    return slidingAttacksFill(orthogonal, diagonal, occupied, s_fillBackend);
+}
+
+BitBoard BitBoard::slidingAttacksFill(const BitBoard& orthogonal,
+                                      const BitBoard& diagonal,
+                                      const BitBoard& occupied,
+                                      FillBackend     backend)
+{
+    assert(isSupported(backend));
+
+#if defined(BITBOARD_AVX2_AVAILABLE)
+    if (backend == AVX2)
+        return BitBoard(avx2Fill(orthogonal, diagonal, occupied));
+#endif
+    return BitBoard(scalarFill(orthogonal, diagonal, occupied));
+}
+
+BitBoard::FillBackend BitBoard::fillBackend()
+{
+    return s_fillBackend;
+}
+
+bool BitBoard::setFillBackend(FillBackend backend)
+{
+    if (!isSupported(backend))
+        return false;
+    s_fillBackend = backend;
+    return true;
+}
+
+bool BitBoard::isSupported(FillBackend backend)
+{
+    switch (backend)
+    {
+    case SCALAR:
+        return true;
+    case AVX2:
+        return s_avx2Supported;
+    default:
+        return false;
+    }
+}
+
+char const * BitBoard::name(FillBackend backend)
+{
+    switch (backend)
+    {
+    case SCALAR: return "scalar";
+    case AVX2:   return "avx2";
+    default:     return "unknown";
+    }
+}
+
+BitBoard BitBoard::between(int r0, int c0, int r1, int c1)
+{
+    assert(r0 >= 0 && r0 < SQUARES_PER_COLUMN);
+    assert(c0 >= 0 && c0 < SQUARES_PER_ROW);
+    assert(r1 >= 0 && r1 < SQUARES_PER_COLUMN);
+    assert(c1 >= 0 && c1 < SQUARES_PER_ROW);
+
+    return BitBoard(s_between[index(r0, c0)][index(r1, c1)]);
+}
+
+BitBoard BitBoard::between(int i0, int i1)
+{
+    assert(i0 >= 0 && i0 < SIZE);
+    assert(i1 >= 0 && i1 < SIZE);
+
+    return BitBoard(s_between[i0][i1]);
+}
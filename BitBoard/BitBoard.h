@@ -20,6 +20,11 @@
 #define BitBoard_h__
 
 #include <algorithm>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 struct Position;
 
@@ -46,19 +51,117 @@ public:
     };
     static int constexpr NUMBER_OF_PIECES = PAWN - KING + 1;
 
+    //! The colors of pawns, which move in opposite directions. White pawns move toward row 0 and black pawns move
+    //! toward row 7.
+    enum PawnColor
+    {
+        WHITE = 0,
+        BLACK
+    };
+
+    //! Implementations of the attacks of sliding pieces (queens, rooks, and bishops)
+    enum SlidingAttackBackend
+    {
+        LOOP,   //!< Masks out the squares hidden by each blocker, one at a time
+        MAGIC,  //!< Looks up the attacks using a magic multiplication hash of the blockers
+        PEXT    //!< Looks up the attacks using the blockers extracted by the BMI2 PEXT instruction
+    };
+
+    //! Implementations of the fill of the attacks of many sliding pieces at once
+    enum FillBackend
+    {
+        SCALAR, //!< Fills each of the 8 directions in turn
+        AVX2    //!< Fills 4 directions at a time, one in each lane of an AVX2 register
+    };
+
     explicit BitBoard(uint64_t i = 0) : board_(i) {}
 
     //! Converts the bitboard to a uint64_t
     operator uint64_t() const { return board_; }
 
     //! Sets the value of the specified square to 1
-    void set(int r, int c) { board_ |= mask(r, c); }
+    void set(int r, int c) { set(index(r, c)); }
+    void set(int i) { board_ |= uint64_t(1) << i; }
 
     //! Sets the value of the specified square to 0
-    void clear(int r, int c) { board_ &= ~mask(r, c); }
+    void clear(int r, int c) { clear(index(r, c)); }
+    void clear(int i) { board_ &= ~(uint64_t(1) << i); }
 
     //! Returns the value of the specified square
-    int test(int r, int c) const { return int((board_ >> index(r, c)) & 1); }
+    int test(int r, int c) const { return test(index(r, c)); }
+    int test(int i) const { return int((board_ >> i) & 1); }
+
+    //! Returns true if no squares are set
+    bool empty() const { return board_ == 0; }
+
+    //! Returns the number of set squares
+    int count() const
+    {
+#if defined(_MSC_VER)
+        return (int)__popcnt64(board_);
+#else
+        return __builtin_popcountll(board_);
+#endif
+    }
+
+    //! Gets the row and column of the lowest-numbered set square. Returns false if no squares are set.
+    bool first(int & r, int & c) const
+    {
+        if (board_ == 0)
+            return false;
+        rowAndColumn(lowestIndex(board_), r, c);
+        return true;
+    }
+
+    //! Gets the row and column of the lowest-numbered set square and clears it. Returns false if no squares are set.
+    bool popFirst(int & r, int & c)
+    {
+        if (board_ == 0)
+            return false;
+        rowAndColumn(lowestIndex(board_), r, c);
+        board_ &= board_ - 1;
+        return true;
+    }
+
+    //! Gets the index (row * 8 + column) of the lowest-numbered set square. Returns false if no squares are set.
+    bool first(int & i) const
+    {
+        if (board_ == 0)
+            return false;
+        i = lowestIndex(board_);
+        return true;
+    }
+
+    //! Gets the index (row * 8 + column) of the lowest-numbered set square and clears it. Returns false if no squares
+    //! are set.
+    bool popFirst(int & i)
+    {
+        if (board_ == 0)
+            return false;
+        i = lowestIndex(board_);
+        board_ &= board_ - 1;
+        return true;
+    }
+
+    //! Iterates over the indexes (row * 8 + column) of the set squares, from lowest to highest.
+    class Iterator
+    {
+    public:
+        explicit Iterator(uint64_t b) : b_(b) {}
+        int        operator *() const { return lowestIndex(b_); }
+        Iterator & operator ++()      { b_ &= b_ - 1; return *this; }
+        bool       operator !=(Iterator const & other) const { return b_ != other.b_; }
+
+    private:
+        uint64_t b_;    // The squares not yet visited
+    };
+
+    //! Returns an iterator to the lowest-numbered set square. Only the set squares are visited, so iterating over the
+    //! occupied squares of a sparse board is much faster than scanning all of them.
+    Iterator begin() const { return Iterator(board_); }
+
+    //! Returns the end iterator
+    Iterator end() const { return Iterator(0); }
 
     //! Reflects the bitboard vertically (for dealing with white pawns)
     void flip();
@@ -75,10 +178,14 @@ public:
     //! @return	BitBoard showing all threatened squares
     //!
     //! @note	En passant is included.
-    //! @note   Assumes playing black (which only matters for pawns)
+    //! @note   Assumes playing black (which only matters for pawns). See pawnThreatened().
 
     static BitBoard threatened(int type, int r, int c);
 
+    //! Returns a BitBoard showing all squares threatened by a piece at a square (row * 8 + column), assuming it isn't
+    //! blocked.
+    static BitBoard threatened(int type, int i);
+
     //! Returns a BitBoard showing all squares threatened by a piece at a position.
     //!
     //! This function returns a BitBoard showing all squares that the specified piece can attack from the specified
@@ -110,7 +217,7 @@ public:
     //!
     //! @note   Pawn capture, including en passant, is not considered.
     //! @note   Castling is not considered
-    //! @note   Assumes playing black (which only matters for pawns)
+    //! @note   Assumes playing black (which only matters for pawns). See pawnDestinations().
 
     static BitBoard destinations(int type, int r, int c);
 
@@ -133,6 +240,160 @@ public:
 
     static BitBoard destinations(int type, int r, int c, const BitBoard& friends, const BitBoard& foes);
 
+    //! Returns a BitBoard showing the squares attacked by a pawn of the given color at a square (row * 8 + column).
+    static BitBoard pawnThreatened(PawnColor color, int i);
+
+    //! Returns a BitBoard showing the squares that a pawn of the given color at a square (row * 8 + column) can move
+    //! to on an empty board. Captures are not included.
+    static BitBoard pawnDestinations(PawnColor color, int i);
+
+    //! @name Set-wise pawn moves
+    //! These functions return the destinations of all the given pawns at once. Each one moves every pawn by the same
+    //! offset, so the pawn that moved to a square is at (square - offset), where the offset is returned by
+    //! pawnAdvance(), pawnAdvanceLeft() or pawnAdvanceRight().
+    //!@{
+
+    //! Returns the change in index (row * 8 + column) of a pawn of the given color moving ahead one row
+    static int pawnAdvance(PawnColor color) { return (color == WHITE) ? -SQUARES_PER_ROW : SQUARES_PER_ROW; }
+
+    //! Returns the change in index of a pawn of the given color capturing toward column 0
+    static int pawnAdvanceLeft(PawnColor color) { return pawnAdvance(color) - 1; }
+
+    //! Returns the change in index of a pawn of the given color capturing toward column 7
+    static int pawnAdvanceRight(PawnColor color) { return pawnAdvance(color) + 1; }
+
+    //! Returns the empty squares that the pawns can move ahead one row to
+    static BitBoard pawnPushes(PawnColor color, BitBoard const & pawns, BitBoard const & occupied)
+    {
+        return BitBoard(shift(pawns, pawnAdvance(color)) & ~occupied.board_);
+    }
+
+    //! Returns the empty squares that the pawns can move ahead two rows to from their starting row
+    static BitBoard pawnDoublePushes(PawnColor color, BitBoard const & pawns, BitBoard const & occupied)
+    {
+        uint64_t startingRow = (color == WHITE) ? rowMask(SQUARES_PER_COLUMN - 2) : rowMask(1);
+        BitBoard one         = pawnPushes(color, BitBoard(pawns.board_ & startingRow), occupied);
+        return pawnPushes(color, one, occupied);
+    }
+
+    //! Returns the squares that the pawns attack toward column 0
+    static BitBoard pawnAttacksLeft(PawnColor color, BitBoard const & pawns)
+    {
+        return BitBoard(shift(pawns.board_ & ~columnMask(0), pawnAdvanceLeft(color)));
+    }
+
+    //! Returns the squares that the pawns attack toward column 7
+    static BitBoard pawnAttacksRight(PawnColor color, BitBoard const & pawns)
+    {
+        return BitBoard(shift(pawns.board_ & ~columnMask(SQUARES_PER_ROW - 1), pawnAdvanceRight(color)));
+    }
+
+    //! Returns the squares that the pawns attack
+    static BitBoard pawnAttacks(PawnColor color, BitBoard const & pawns)
+    {
+        return BitBoard(pawnAttacksLeft(color, pawns).board_ | pawnAttacksRight(color, pawns).board_);
+    }
+
+    //! Returns a mask of the given row
+    static uint64_t rowMask(int r) { return uint64_t(ROW_MASK) << (SQUARES_PER_ROW * r); }
+
+    //! Returns a mask of the given column
+    static uint64_t columnMask(int c) { return uint64_t(0x0101010101010101) << c; }
+
+    //!@}
+
+    //! Returns a BitBoard showing the squares strictly between two squares.
+    //!
+    //! @param  r0              Row of the first square
+    //! @param  c0              Column of the first square
+    //! @param  r1              Row of the second square
+    //! @param  c1              Column of the second square
+    //!
+    //! @return	BitBoard showing the squares between the two squares, excluding both of them
+    //!
+    //! @note   If the two squares do not share a row, column, or diagonal, the result is empty.
+
+    static BitBoard between(int r0, int c0, int r1, int c1);
+
+    //! Returns a BitBoard showing the squares strictly between two squares (row * 8 + column).
+    static BitBoard between(int i0, int i1);
+
+    //! Returns a BitBoard showing all squares attacked by a sliding piece at a position.
+    //!
+    //! This function returns a BitBoard showing all squares that a queen, rook, or bishop attacks from the specified
+    //! position, given the locations of all pieces on the board. Occupied squares that are attacked are included,
+    //! regardless of the color of the piece occupying them.
+    //!
+    //! @param  type            Type of piece (QUEEN, ROOK, or BISHOP)
+    //! @param  r               The piece's row
+    //! @param  c               The piece's column
+    //! @param  occupied        The positions of all pieces
+    //!
+    //! @return BitBoard showing all attacked squares
+    //!
+    //! @note   The backend returned by slidingAttackBackend() is used.
+
+    static BitBoard slidingAttacks(int type, int r, int c, const BitBoard& occupied);
+
+    //! Returns a BitBoard showing all squares attacked by a sliding piece at a square (row * 8 + column).
+    static BitBoard slidingAttacks(int type, int i, const BitBoard& occupied);
+
+    //! Returns a BitBoard showing all squares attacked by a sliding piece at a position, using a specific backend.
+    //!
+    //! @note   The backend must be supported by this CPU. See isSupported().
+
+    static BitBoard slidingAttacks(int type, int r, int c, const BitBoard& occupied, SlidingAttackBackend backend);
+
+    //! Returns the backend used for sliding attacks. The fastest backend supported by the CPU is chosen at startup.
+    static SlidingAttackBackend slidingAttackBackend();
+
+    //! Overrides the backend used for sliding attacks. Returns false if the backend is not supported by this CPU.
+    static bool setSlidingAttackBackend(SlidingAttackBackend backend);
+
+    //! Returns true if the backend is supported by this CPU
+    static bool isSupported(SlidingAttackBackend backend);
+
+    //! Returns the name of a backend
+    static char const * name(SlidingAttackBackend backend);
+
+    //! Returns a BitBoard showing all squares attacked by a set of sliding pieces.
+    //!
+    //! The attacks of all of the pieces are computed at once, by filling each of the 8 directions from all of the
+    //! pieces in three shifts (Kogge-Stone). Occupied squares that are attacked are included, regardless of the color
+    //! of the piece occupying them. Only the union of the attacks is returned, so it can't tell how many pieces
+    //! attack a square.
+    //!
+    //! @param  orthogonal      The positions of pieces that slide along rows and columns (rooks and queens)
+    //! @param  diagonal        The positions of pieces that slide along diagonals (bishops and queens)
+    //! @param  occupied        The positions of all pieces
+    //!
+    //! @return BitBoard showing all attacked squares
+    //!
+    //! @note   The backend returned by fillBackend() is used.
+
+    static BitBoard slidingAttacksFill(const BitBoard& orthogonal, const BitBoard& diagonal, const BitBoard& occupied);
+
+    //! Returns a BitBoard showing all squares attacked by a set of sliding pieces, using a specific backend.
+    //!
+    //! @note   The backend must be supported by this CPU. See isSupported().
+
+    static BitBoard slidingAttacksFill(const BitBoard& orthogonal,
+                                       const BitBoard& diagonal,
+                                       const BitBoard& occupied,
+                                       FillBackend     backend);
+
+    //! Returns the backend used for fills. The fastest backend supported by the CPU is chosen at startup.
+    static FillBackend fillBackend();
+
+    //! Overrides the backend used for fills. Returns false if the backend is not supported by this CPU.
+    static bool setFillBackend(FillBackend backend);
+
+    //! Returns true if the backend is supported by this CPU
+    static bool isSupported(FillBackend backend);
+
+    //! Returns the name of a backend
+    static char const * name(FillBackend backend);
+
 private:
 
     // Returns the index for the given row and column
@@ -141,9 +402,24 @@ private:
     // Returns the row and column for the given index
     static void rowAndColumn(int index, int & r, int & c) { r = index / SQUARES_PER_ROW; c = index % SQUARES_PER_ROW; }
 
+    // Returns the index of the lowest set bit (b must not be 0)
+    static int lowestIndex(uint64_t b)
+    {
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanForward64(&i, b);
+        return (int)i;
+#else
+        return __builtin_ctzll(b);
+#endif
+    }
+
     // Returns a mask for the square at the given row and column
     static uint64_t mask(int r, int c) { return (uint64_t)1 << index(r, c); }
 
+    // Shifts the squares by the given change in index
+    static uint64_t shift(uint64_t b, int offset) { return (offset > 0) ? b << offset : b >> -offset; }
+
     // Returns the contents of the given row
     unsigned row(int r) const { return unsigned((board_ >> (SQUARES_PER_ROW * r)) & ROW_MASK); }
 
@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "BitBoard/BitBoard.h"
 
+#include <random>
+#include <vector>
+
 TEST(BitBoardTest, Constructor_default)
 {
     BitBoard b;
@@ -118,3 +121,269 @@ TEST(BitBoardTest, Destinations_blockers)
     EXPECT_EQ(queenDest.test(3, 4), 0);
 #endif
 }
+
+TEST(BitBoardTest, Between)
+{
+    // Same row
+    EXPECT_EQ(uint64_t(BitBoard::between(0, 0, 0, 3)), 0x0000000000000006ULL);
+    EXPECT_EQ(uint64_t(BitBoard::between(0, 3, 0, 0)), 0x0000000000000006ULL);
+
+    // Same column
+    EXPECT_EQ(uint64_t(BitBoard::between(0, 0, 3, 0)), 0x0000000000010100ULL);
+
+    // Same diagonal
+    EXPECT_EQ(uint64_t(BitBoard::between(0, 0, 3, 3)), 0x0000000000040200ULL);
+    EXPECT_EQ(uint64_t(BitBoard::between(3, 0, 0, 3)), 0x0000000000020400ULL);
+
+    // Adjacent
+    EXPECT_EQ(uint64_t(BitBoard::between(4, 4, 5, 5)), 0ULL);
+
+    // Not aligned
+    EXPECT_EQ(uint64_t(BitBoard::between(0, 0, 2, 1)), 0ULL);
+}
+
+TEST(BitBoardTest, SlidingAttacks)
+{
+    // Rook on a8 (0, 0) blocked by pieces on a6 (2, 0) and d8 (0, 3)
+    BitBoard occupied;
+    occupied.set(2, 0);
+    occupied.set(0, 3);
+    EXPECT_EQ(uint64_t(BitBoard::slidingAttacks(BitBoard::ROOK, 0, 0, occupied, BitBoard::LOOP)), 0x000000000001010EULL);
+    EXPECT_EQ(uint64_t(BitBoard::slidingAttacks(BitBoard::ROOK, 0, 0, occupied, BitBoard::MAGIC)), 0x000000000001010EULL);
+
+    // Bishop on d5 (3, 3) blocked by a piece on f7 (1, 5)
+    occupied = BitBoard();
+    occupied.set(1, 5);
+    EXPECT_EQ(uint64_t(BitBoard::slidingAttacks(BitBoard::BISHOP, 3, 3, occupied, BitBoard::LOOP)), 0x8041221400142201ULL);
+    EXPECT_EQ(uint64_t(BitBoard::slidingAttacks(BitBoard::BISHOP, 3, 3, occupied, BitBoard::MAGIC)), 0x8041221400142201ULL);
+}
+
+TEST(BitBoardTest, IndexOverloads)
+{
+    // Every square addressed by index is the same square addressed by row and column
+    BitBoard occupied(0x0000240000420000ULL);
+    for (int r = 0; r < BitBoard::SQUARES_PER_COLUMN; ++r)
+    {
+        for (int c = 0; c < BitBoard::SQUARES_PER_ROW; ++c)
+        {
+            int i = r * BitBoard::SQUARES_PER_ROW + c;
+
+            BitBoard a;
+            BitBoard b;
+            a.set(r, c);
+            b.set(i);
+            EXPECT_EQ(uint64_t(a), uint64_t(b));
+            EXPECT_EQ(b.test(i), 1);
+            b.clear(i);
+            EXPECT_TRUE(b.empty());
+
+            EXPECT_EQ(uint64_t(BitBoard::threatened(BitBoard::KNIGHT, i)), uint64_t(BitBoard::threatened(BitBoard::KNIGHT, r, c)));
+            EXPECT_EQ(uint64_t(BitBoard::slidingAttacks(BitBoard::QUEEN, i, occupied)),
+                      uint64_t(BitBoard::slidingAttacks(BitBoard::QUEEN, r, c, occupied)));
+            EXPECT_EQ(uint64_t(BitBoard::between(0, i)), uint64_t(BitBoard::between(0, 0, r, c)));
+        }
+    }
+
+    int      i;
+    BitBoard b(0x0000000000200100ULL);
+    EXPECT_TRUE(b.first(i));
+    EXPECT_EQ(i, 8);
+    EXPECT_TRUE(b.popFirst(i));
+    EXPECT_EQ(i, 8);
+    EXPECT_TRUE(b.popFirst(i));
+    EXPECT_EQ(i, 21);
+    EXPECT_FALSE(b.popFirst(i));
+}
+
+TEST(BitBoardTest, Iterator)
+{
+    std::vector<int> visited;
+    for (int i : BitBoard(0x8000000000200101ULL))
+        visited.push_back(i);
+    EXPECT_EQ(visited, (std::vector<int>{ 0, 8, 21, 63 }));
+
+    visited.clear();
+    for (int i : BitBoard())
+        visited.push_back(i);
+    EXPECT_TRUE(visited.empty());
+}
+
+TEST(BitBoardTest, Pawns)
+{
+    // The black pawn tables are the same as the pawn rows of the original tables
+    for (int r = 1; r < BitBoard::SQUARES_PER_COLUMN - 1; ++r)
+    {
+        for (int c = 0; c < BitBoard::SQUARES_PER_ROW; ++c)
+        {
+            int i = r * BitBoard::SQUARES_PER_ROW + c;
+            EXPECT_EQ(uint64_t(BitBoard::pawnThreatened(BitBoard::BLACK, i)), uint64_t(BitBoard::threatened(BitBoard::PAWN, r, c)));
+            EXPECT_EQ(uint64_t(BitBoard::pawnDestinations(BitBoard::BLACK, i)), uint64_t(BitBoard::destinations(BitBoard::PAWN, r, c)));
+        }
+    }
+
+    // The white pawn tables are the black pawn tables reflected vertically, without calling flip()
+    for (int i = 0; i < BitBoard::SIZE; ++i)
+    {
+        int      reflected = i ^ (BitBoard::SIZE - BitBoard::SQUARES_PER_ROW);
+        BitBoard threatened = BitBoard::pawnThreatened(BitBoard::BLACK, reflected);
+        BitBoard destinations = BitBoard::pawnDestinations(BitBoard::BLACK, reflected);
+        threatened.flip();
+        destinations.flip();
+        EXPECT_EQ(uint64_t(BitBoard::pawnThreatened(BitBoard::WHITE, i)), uint64_t(threatened));
+        EXPECT_EQ(uint64_t(BitBoard::pawnDestinations(BitBoard::WHITE, i)), uint64_t(destinations));
+    }
+
+    // White pawns on a2, d2 and h7 with a piece on d3 and one on g8
+    BitBoard pawns;
+    pawns.set(6, 0);
+    pawns.set(6, 3);
+    pawns.set(1, 7);
+    BitBoard occupied = pawns;
+    occupied.set(5, 3);
+    occupied.set(0, 6);
+
+    BitBoard pushes;
+    pushes.set(5, 0);
+    pushes.set(0, 7);
+    EXPECT_EQ(uint64_t(BitBoard::pawnPushes(BitBoard::WHITE, pawns, occupied)), uint64_t(pushes));
+
+    BitBoard doublePushes;
+    doublePushes.set(4, 0);
+    EXPECT_EQ(uint64_t(BitBoard::pawnDoublePushes(BitBoard::WHITE, pawns, occupied)), uint64_t(doublePushes));
+
+    BitBoard left;
+    left.set(5, 2);
+    left.set(0, 6);
+    EXPECT_EQ(uint64_t(BitBoard::pawnAttacksLeft(BitBoard::WHITE, pawns)), uint64_t(left));
+
+    BitBoard right;
+    right.set(5, 1);
+    right.set(5, 4);
+    EXPECT_EQ(uint64_t(BitBoard::pawnAttacksRight(BitBoard::WHITE, pawns)), uint64_t(right));
+
+    // The pawn that moves to a square is found by subtracting the offset
+    EXPECT_EQ(5 * 8 + 0 - BitBoard::pawnAdvance(BitBoard::WHITE), 6 * 8 + 0);
+    EXPECT_EQ(0 * 8 + 6 - BitBoard::pawnAdvanceLeft(BitBoard::WHITE), 1 * 8 + 7);
+    EXPECT_EQ(5 * 8 + 4 - BitBoard::pawnAdvanceRight(BitBoard::WHITE), 6 * 8 + 3);
+    EXPECT_EQ(2 * 8 + 4 - BitBoard::pawnAdvanceLeft(BitBoard::BLACK), 1 * 8 + 5);
+}
+
+TEST(BitBoardTest, SlidingAttacks_magicMatchesLoop)
+{
+    std::mt19937_64 rng;
+    int const types[] = { BitBoard::QUEEN, BitBoard::ROOK, BitBoard::BISHOP };
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        // Sparse, medium, and dense occupancies
+        uint64_t occupancy = rng();
+        if (i % 3 == 0)
+            occupancy &= rng() & rng();
+        else if (i % 3 == 1)
+            occupancy &= rng();
+
+        BitBoard occupied(occupancy);
+        for (int type : types)
+        {
+            for (int r = 0; r < BitBoard::SQUARES_PER_COLUMN; ++r)
+            {
+                for (int c = 0; c < BitBoard::SQUARES_PER_ROW; ++c)
+                {
+                    BitBoard expected = BitBoard::slidingAttacks(type, r, c, occupied, BitBoard::LOOP);
+                    BitBoard actual   = BitBoard::slidingAttacks(type, r, c, occupied, BitBoard::MAGIC);
+                    ASSERT_EQ(uint64_t(actual), uint64_t(expected))
+                        << "type " << type << " at (" << r << ", " << c << ") with occupancy " << std::hex << occupancy;
+                }
+            }
+        }
+    }
+}
+
+TEST(BitBoardTest, SlidingAttacks_pextMatchesLoop)
+{
+    if (!BitBoard::isSupported(BitBoard::PEXT))
+        GTEST_SKIP() << "PEXT is not supported by this CPU.";
+
+    std::mt19937_64 rng;
+    int const types[] = { BitBoard::QUEEN, BitBoard::ROOK, BitBoard::BISHOP };
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        // Sparse, medium, and dense occupancies
+        uint64_t occupancy = rng();
+        if (i % 3 == 0)
+            occupancy &= rng() & rng();
+        else if (i % 3 == 1)
+            occupancy &= rng();
+
+        BitBoard occupied(occupancy);
+        for (int type : types)
+        {
+            for (int r = 0; r < BitBoard::SQUARES_PER_COLUMN; ++r)
+            {
+                for (int c = 0; c < BitBoard::SQUARES_PER_ROW; ++c)
+                {
+                    BitBoard expected = BitBoard::slidingAttacks(type, r, c, occupied, BitBoard::LOOP);
+                    BitBoard actual   = BitBoard::slidingAttacks(type, r, c, occupied, BitBoard::PEXT);
+                    ASSERT_EQ(uint64_t(actual), uint64_t(expected))
+                        << "type " << type << " at (" << r << ", " << c << ") with occupancy " << std::hex << occupancy;
+                }
+            }
+        }
+    }
+}
+
+TEST(BitBoardTest, SlidingAttackBackend)
+{
+    BitBoard::SlidingAttackBackend active = BitBoard::slidingAttackBackend();
+    EXPECT_TRUE(BitBoard::isSupported(active));
+    EXPECT_NE(active, BitBoard::LOOP);
+    EXPECT_TRUE(BitBoard::isSupported(BitBoard::LOOP));
+    EXPECT_TRUE(BitBoard::isSupported(BitBoard::MAGIC));
+    EXPECT_STREQ(BitBoard::name(BitBoard::MAGIC), "magic");
+
+    // The results must not depend on the backend
+    BitBoard occupied(0x0000102400000800ULL);
+    BitBoard expected = BitBoard::threatened(BitBoard::QUEEN, 4, 4, BitBoard(), occupied);
+    EXPECT_TRUE(BitBoard::setSlidingAttackBackend(BitBoard::LOOP));
+    EXPECT_EQ(uint64_t(BitBoard::threatened(BitBoard::QUEEN, 4, 4, BitBoard(), occupied)), uint64_t(expected));
+    EXPECT_TRUE(BitBoard::setSlidingAttackBackend(active));
+}
+
+TEST(BitBoardTest, SlidingAttacksFill)
+{
+    std::mt19937_64 rng;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        // Sparse, medium, and dense occupancies, with a few of the pieces sliding
+        uint64_t occupancy = rng();
+        if (i % 3 == 0)
+            occupancy &= rng() & rng();
+        else if (i % 3 == 1)
+            occupancy &= rng();
+        uint64_t orthogonal = occupancy & rng() & rng();
+        uint64_t diagonal   = occupancy & rng() & rng();
+
+        // The fill is the union of the attacks of each piece
+        BitBoard occupied(occupancy);
+        uint64_t expected = 0;
+        for (int s : BitBoard(orthogonal))
+            expected |= BitBoard::slidingAttacks(BitBoard::ROOK, s, occupied);
+        for (int s : BitBoard(diagonal))
+            expected |= BitBoard::slidingAttacks(BitBoard::BISHOP, s, occupied);
+
+        BitBoard actual = BitBoard::slidingAttacksFill(BitBoard(orthogonal), BitBoard(diagonal), occupied, BitBoard::SCALAR);
+        ASSERT_EQ(uint64_t(actual), expected) << "occupancy " << std::hex << occupancy;
+
+        if (BitBoard::isSupported(BitBoard::AVX2))
+        {
+            actual = BitBoard::slidingAttacksFill(BitBoard(orthogonal), BitBoard(diagonal), occupied, BitBoard::AVX2);
+            ASSERT_EQ(uint64_t(actual), expected) << "occupancy " << std::hex << occupancy;
+        }
+    }
+
+    EXPECT_TRUE(BitBoard::isSupported(BitBoard::fillBackend()));
+    EXPECT_TRUE(BitBoard::isSupported(BitBoard::SCALAR));
+    EXPECT_STREQ(BitBoard::name(BitBoard::SCALAR), "scalar");
+}
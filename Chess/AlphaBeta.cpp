@@ -0,0 +1,681 @@
+#include "AlphaBeta.h"
+
+#include "Board.h"
+#include "GameState.h"
+#include "Move.h"
+#include "MoveGenerator.h"
+#include "MoveList.h"
+#include "MoveOrdering.h"
+#include "PieceMoves.h"
+#include "Square.h"
+#include "StagedMoveGenerator.h"
+#include "StaticEvaluator.h"
+#include "Types.h"
+
+#include <BitBoard/BitBoard.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace
+{
+float constexpr INFINITE_VALUE = std::numeric_limits<float>::infinity();
+float constexpr MATE_VALUE     = StaticEvaluator::CHECKMATE_VALUE;
+
+// Values within this many plies of MATE_VALUE are mates
+int constexpr MAX_PLY = 1000;
+
+// Number of entries in the table of hash moves
+size_t constexpr HASH_MOVES = 1 << 18;
+
+// Returns the number of threads to use, given the number requested (0 means one per hardware thread)
+int threadCount(int threads)
+{
+    return (threads > 0) ? threads : std::max(1, (int)std::thread::hardware_concurrency());
+}
+} // anonymous namespace
+
+// A node whose remaining moves are being searched as tasks
+struct AlphaBeta::SplitPoint
+{
+    SplitPoint(SplitPoint * parent,
+               GameState &  state,
+               size_t       first,
+               int          depth,
+               int          ply,
+               float        alpha,
+               float        beta,
+               float        best,
+               size_t       bestIndex,
+               Move const & bestMove,
+               int          owner)
+        : parent(parent)
+        , ownerState(state)
+        , state(state)
+        , first(first)
+        , depth(depth)
+        , ply(ply)
+        , beta(beta)
+        , owner(owner)
+        , pending(0)
+        , alpha(alpha)
+        , best(best)
+        , bestIndex(bestIndex)
+        , bestMove(bestMove)
+    {
+    }
+
+    // Returns true if this split point is the specified split point or is below it
+    bool isBelow(SplitPoint const * ancestor) const
+    {
+        for (SplitPoint const * s = this; s; s = s->parent)
+        {
+            if (s == ancestor)
+                return true;
+        }
+        return false;
+    }
+
+    SplitPoint *      parent;       // The closest split point above this one
+    GameState &       ownerState;   // The owner's state, which only the owner may change
+    GameState const   state;        // A copy of the state for the other threads, which can't use the owner's
+    MoveList          moves;        // The moves searched as tasks
+    size_t            first;        // Number of moves searched before the split
+    int               depth;
+    int               ply;
+    float             beta;
+    int               owner;        // Id of the thread that owns the node
+    std::atomic<bool> cutoff{ false };
+    std::atomic<int>  pending;      // Number of tasks that are not finished
+
+    std::mutex mutex;       // Guards the members below
+    float      alpha;
+    float      best;
+    size_t     bestIndex;   // Index of the best move in the order that the moves were generated
+    Move       bestMove;
+};
+
+// The state of one of the threads
+struct AlphaBeta::Worker
+{
+    explicit Worker(int id) : id(id) {}
+
+    int          id;
+    WorkQueue    queue;
+    MoveOrdering ordering;
+    Statistics   statistics;
+};
+
+AlphaBeta::Statistics & AlphaBeta::Statistics::operator +=(Statistics const & other)
+{
+    nodes               += other.nodes;
+    qnodes              += other.qnodes;
+    splits              += other.splits;
+    tasks               += other.tasks;
+    steals              += other.steals;
+    abandoned           += other.abandoned;
+    splitCutoffs        += other.splitCutoffs;
+    nullMoveCutoffs     += other.nullMoveCutoffs;
+    failedVerifications += other.failedVerifications;
+    reductions          += other.reductions;
+    researches          += other.researches;
+    cutoffs             += other.cutoffs;
+    firstMoveCutoffs    += other.firstMoveCutoffs;
+    seePrunes           += other.seePrunes;
+    return *this;
+}
+
+void AlphaBeta::WorkQueue::push(Task const & task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(task);
+}
+
+bool AlphaBeta::WorkQueue::pop(SplitPoint const * splitPoint, Task & task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty() || !tasks_.back().splitPoint->isBelow(splitPoint))
+        return false;
+    task = tasks_.back();
+    tasks_.pop_back();
+    return true;
+}
+
+bool AlphaBeta::WorkQueue::steal(SplitPoint const * splitPoint, Task & task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto i = tasks_.begin(); i != tasks_.end(); ++i)
+    {
+        if (!splitPoint || i->splitPoint->isBelow(splitPoint))
+        {
+            task = *i;
+            tasks_.erase(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+AlphaBeta::Options AlphaBeta::Options::exact()
+{
+    Options options;
+    options.nullMoveReduction = 0;
+    options.lmrMinMoves       = 0;
+    return options;
+}
+
+AlphaBeta::AlphaBeta(std::shared_ptr<StaticEvaluator> evaluator, int threads /*= 1*/, int minSplitDepth /*= 2*/)
+    : AlphaBeta(evaluator, threads, minSplitDepth, (threadCount(threads) > 1) ? Options::exact() : Options())
+{
+}
+
+AlphaBeta::AlphaBeta(std::shared_ptr<StaticEvaluator> evaluator,
+                     int                              threads,
+                     int                              minSplitDepth,
+                     Options const &                  options)
+    : evaluator_(evaluator)
+    , threads_(threadCount(threads))
+    , minSplitDepth_(minSplitDepth)
+    , options_(options)
+    , hashMoves_(HASH_MOVES)
+    , done_(false)
+{
+    // The workers persist between searches so that their move ordering tables carry over to the next search
+    for (int id = 0; id < threads_; ++id)
+    {
+        workers_.emplace_back(new Worker(id));
+    }
+}
+
+AlphaBeta::~AlphaBeta() = default;
+
+std::shared_ptr<GameState> AlphaBeta::search(GameState const &         state,
+                                             int                       depth,
+                                             std::atomic<bool> const * abort /*= nullptr*/,
+                                             float *                   value /*= nullptr*/)
+{
+    assert(depth > 0);
+
+    abort_ = abort;
+    done_  = false;
+
+    // Old history is given less weight
+    for (auto & worker : workers_)
+    {
+        worker->statistics = Statistics();
+        worker->ordering.age();
+    }
+
+    // The helpers steal work until the root has been searched
+    std::vector<std::thread> helpers;
+    for (int id = 1; id < threads_; ++id)
+    {
+        helpers.emplace_back([this, id] { idle(*workers_[id]); });
+    }
+
+    // The best response found by the previous search of this state is searched first, since it is likely to be best
+    // again. The moves at the root are not ordered by the threads' tables, so that their order (and the response chosen
+    // among moves with equal values) does not depend on which thread searched what.
+    // The main thread walks its own copy of the state, making and unmaking moves as it goes.
+    Worker & main = *workers_[0];
+    ++main.statistics.nodes;
+    GameState           root(state);
+    bool                hasPrevious = root.fingerprint() == rootFingerprint_;
+    StagedMoveGenerator moves(root, hasPrevious ? &rootBest_ : nullptr);
+    Move                bestMove;
+    float               best = searchMoves(root, moves, depth, -INFINITE_VALUE, INFINITE_VALUE, 0, nullptr, main, bestMove);
+
+    done_ = true;
+    for (auto & helper : helpers)
+    {
+        helper.join();
+    }
+    for (auto const & worker : workers_)
+    {
+        statistics_ += worker->statistics;
+    }
+
+    // The best response is kept unless the search was aborted or there are no legal moves
+    std::shared_ptr<GameState> response;
+    if (!stopped(nullptr) && best > -INFINITE_VALUE)
+    {
+        response = std::make_shared<GameState>(state);
+        response->makeMove(bestMove);
+        rootFingerprint_ = state.fingerprint();
+        rootBest_        = bestMove;
+        if (value)
+            *value = best;
+    }
+    return response;
+}
+
+float AlphaBeta::search(GameState &  state,
+                        int          depth,
+                        float        alpha,
+                        float        beta,
+                        int          ply,
+                        SplitPoint * parent,
+                        Worker &     worker,
+                        bool         nullMoveAllowed /*= true*/)
+{
+    if (depth <= 0)
+        return quiesce(state, alpha, beta, ply, parent, worker);
+
+    ++worker.statistics.nodes;
+    if (stopped(parent))
+        return 0.0f;
+
+    if (nullMoveAllowed && nullMoveFailsHigh(state, depth, beta, ply, parent, worker))
+    {
+        ++worker.statistics.nullMoveCutoffs;
+        return beta;
+    }
+
+    // The best move found by an earlier search of this node, by any thread, is searched first
+    Move                hashMove;
+    bool                hasHashMove = hashMoves_.probe(state.fingerprint(), state.board_, hashMove);
+    StagedMoveGenerator moves(state,
+                              hasHashMove ? &hashMove : nullptr,
+                              worker.ordering.killers(ply + 1),
+                              StagedMoveGenerator::MAX_KILLERS,
+                              &worker.ordering);
+    Move                bestMove;
+    float               best = searchMoves(state, moves, depth, alpha, beta, ply, parent, worker, bestMove);
+
+    // If there are no legal moves, then it is checkmate or stalemate
+    if (best == -INFINITE_VALUE)
+        return state.inCheck_ ? -(MATE_VALUE - ply) : 0.0f;
+
+    // If every move failed low, none of them is known to be best. A stopped search's best move is not known either.
+    if (best > alpha && !stopped(parent))
+        hashMoves_.store(state.fingerprint(), bestMove, depth);
+    return best;
+}
+
+float AlphaBeta::searchMoves(GameState &           state,
+                             StagedMoveGenerator & moves,
+                             int                   depth,
+                             float                 alpha,
+                             float                 beta,
+                             int                   ply,
+                             SplitPoint *          parent,
+                             Worker &              worker,
+                             Move &                bestMove)
+{
+    float  best      = -INFINITE_VALUE;
+    size_t bestIndex = 0;
+    Move   move;
+    for (size_t i = 0; moves.next(move); ++i)
+    {
+        // Once the eldest brother has been searched, the remaining moves can be searched in parallel
+        if (i > 0 && threads_ > 1 && depth >= minSplitDepth_)
+        {
+            SplitPoint splitPoint(parent, state, i, depth, ply, alpha, beta, best, bestIndex, bestMove, worker.id);
+            do
+            {
+                splitPoint.moves.push_back(move);
+            }
+            while (moves.next(move));
+            split(splitPoint, worker);
+            best     = splitPoint.best;
+            bestMove = splitPoint.bestMove;
+            break;
+        }
+
+        float value = searchChild(state, move, i, depth, alpha, beta, ply, parent, worker);
+        if (stopped(parent))
+            return 0.0f;
+        if (value > best)
+        {
+            best      = value;
+            bestIndex = i;
+            bestMove  = move;
+            alpha     = std::max(alpha, value);
+            if (alpha >= beta)
+            {
+                ++worker.statistics.cutoffs;
+                if (i == 0)
+                    ++worker.statistics.firstMoveCutoffs;
+                worker.ordering.recordCutoff(state, move, depth, ply + 1);
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+bool AlphaBeta::nullMoveFailsHigh(GameState &  state,
+                                  int          depth,
+                                  float        beta,
+                                  int          ply,
+                                  SplitPoint * parent,
+                                  Worker &     worker)
+{
+    // A null move is not tried when it would be illegal, when the depth is too shallow for the savings to matter, when
+    // a fail high would not be believed (mate scores), or when the static value suggests that it would fail low.
+    if (options_.nullMoveReduction <= 0 || depth < options_.nullMoveMinDepth || state.inCheck_)
+        return false;
+    if (beta >= MATE_VALUE - MAX_PLY || evaluate(state) < beta)
+        return false;
+
+    // Search the position with the other player to move, with a null window at beta
+    GameState::UndoInfo undo;
+    state.makeNullMove(undo);
+    int   reducedDepth = depth - 1 - options_.nullMoveReduction;
+    float nullAlpha    = std::nextafter(beta, -INFINITE_VALUE);
+    float value        = -search(state, reducedDepth, -beta, -nullAlpha, ply + 1, parent, worker, false);
+    state.unmakeNullMove(undo);
+    if (stopped(parent) || value < beta)
+        return false;
+
+    // In zugzwang, passing is better than any move, so with few pieces the fail high is verified by searching the
+    // node itself to the reduced depth (without null moves)
+    Board const & board        = state.board_;
+    uint64_t      pawnsAndKing = uint64_t(board.pieces(PieceTypeId::PAWN, state.whoseTurn_)) |
+                                 uint64_t(board.pieces(PieceTypeId::KING, state.whoseTurn_));
+    BitBoard      pieces(uint64_t(board.occupied(state.whoseTurn_)) & ~pawnsAndKing);
+    if (pieces.count() <= options_.verifyPieces)
+    {
+        value = search(state, depth - options_.nullMoveReduction, nullAlpha, beta, ply, parent, worker, false);
+        if (stopped(parent) || value < beta)
+        {
+            ++worker.statistics.failedVerifications;
+            return false;
+        }
+    }
+    return true;
+}
+
+float AlphaBeta::searchChild(GameState &  state,
+                             Move const & move,
+                             size_t       index,
+                             int          depth,
+                             float        alpha,
+                             float        beta,
+                             int          ply,
+                             SplitPoint * parent,
+                             Worker &     worker)
+{
+    bool                inCheck = state.inCheck_;
+    GameState::UndoInfo undo;
+    state.makeMove(move, undo);
+
+    // A late quiet move that doesn't get out of or give check is unlikely to be best, so it is searched at a reduced
+    // depth with a null window at alpha. Later moves are reduced more, and moves that have caused cutoffs before are
+    // reduced less.
+    int reduction = 0;
+    if (options_.lmrMinMoves > 0 &&
+        (int)index >= options_.lmrMinMoves &&
+        depth >= options_.lmrMinDepth &&
+        !inCheck &&
+        !state.inCheck_ &&
+        !move.isCapture() &&
+        !move.isPromotion())
+    {
+        reduction = ((int)index >= 2 * options_.lmrMinMoves) ? 2 : 1;
+        if (worker.ordering.history(move) >= options_.lmrHistory)
+            --reduction;
+        reduction = std::min(reduction, depth - 2);
+    }
+
+    float value;
+    if (reduction > 0)
+    {
+        ++worker.statistics.reductions;
+        float nullBeta = std::nextafter(alpha, INFINITE_VALUE);
+        value = -search(state, depth - 1 - reduction, -nullBeta, -alpha, ply + 1, parent, worker);
+        if (value > alpha)
+        {
+            ++worker.statistics.researches;
+            value = -search(state, depth - 1, -beta, -alpha, ply + 1, parent, worker);
+        }
+    }
+    else
+    {
+        value = -search(state, depth - 1, -beta, -alpha, ply + 1, parent, worker);
+    }
+
+    state.unmakeMove(move, undo);
+    return value;
+}
+
+float AlphaBeta::quiesce(GameState &  state,
+                         float        alpha,
+                         float        beta,
+                         int          ply,
+                         SplitPoint * parent,
+                         Worker &     worker)
+{
+    ++worker.statistics.qnodes;
+    if (stopped(parent))
+        return 0.0f;
+
+    Color justMoved = (state.whoseTurn_ == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    if (state.kingIsAttacked(justMoved))
+        return MATE_VALUE - ply;
+
+    // A player in check can't stand pat, since the static value ignores the threat to the king. Instead, every legal
+    // evasion is searched, and with none it is checkmate. A long enough series of checks is cut off at the static value.
+    if (state.inCheck_)
+    {
+        if (ply >= MAX_PLY)
+            return evaluate(state);
+
+        MoveList evasions;
+        MoveGenerator::generateLegalMoves(state, evasions);
+        float best = -(MATE_VALUE - ply);
+        for (auto const & move : evasions)
+        {
+            GameState::UndoInfo undo;
+            state.makeMove(move, undo);
+            float value = -quiesce(state, -beta, -alpha, ply + 1, parent, worker);
+            state.unmakeMove(move, undo);
+            if (stopped(parent))
+                return 0.0f;
+            if (value > best)
+            {
+                best  = value;
+                alpha = std::max(alpha, value);
+                if (alpha >= beta)
+                    break;
+            }
+        }
+        return best;
+    }
+
+    // Stand pat. The player to move is assumed to be able to do at least as well as the static value by not
+    // capturing, so it is a lower bound.
+    float best = evaluate(state);
+    if (best >= beta)
+        return best;
+    alpha = std::max(alpha, best);
+
+    // Search the captures and promotions that don't lose material, those that win the most first. Ties are broken by
+    // MVV/LVA.
+    MoveList generated;
+    PieceMoves::generatePossibleCaptures(state, generated);
+    MoveList moves;
+    int      scores[MoveList::CAPACITY];
+    for (auto const & move : generated)
+    {
+        int see = StaticEvaluator::see(state, move);
+        if (see < 0)
+        {
+            ++worker.statistics.seePrunes;
+            continue;
+        }
+        scores[moves.size()] = see * MoveOrdering::SEE_SCALE + StagedMoveGenerator::mvvLva(state, move);
+        moves.push_back(move);
+    }
+
+    for (size_t i = 0; i < moves.size(); ++i)
+    {
+        size_t next = std::max_element(scores + i, scores + moves.size()) - scores;
+        std::swap(moves[i], moves[next]);
+        std::swap(scores[i], scores[next]);
+
+        GameState::UndoInfo undo;
+        state.makeMove(moves[i], undo);
+        float value = -quiesce(state, -beta, -alpha, ply + 1, parent, worker);
+        state.unmakeMove(moves[i], undo);
+        if (stopped(parent))
+            return 0.0f;
+        if (value > best)
+        {
+            best  = value;
+            alpha = std::max(alpha, value);
+            if (alpha >= beta)
+                break;
+        }
+    }
+    return best;
+}
+
+float AlphaBeta::evaluate(GameState const & state) const
+{
+    // The evaluator's values are from the point of view of white
+    float value = evaluator_->evaluate(state);
+    return (state.whoseTurn_ == Color::WHITE) ? value : -value;
+}
+
+void AlphaBeta::split(SplitPoint & splitPoint, Worker & worker)
+{
+    ++worker.statistics.splits;
+
+    // The tasks are pushed in reverse order so that the owner searches them in order from the back of its queue, and
+    // the other threads steal the last (and least promising) ones from the front.
+    splitPoint.pending = (int)splitPoint.moves.size();
+    for (size_t i = splitPoint.moves.size(); i-- > 0;)
+    {
+        worker.queue.push({ &splitPoint, i });
+    }
+
+    // Search the tasks and help with the work below this split point until all of its tasks are done
+    Task task;
+    while (splitPoint.pending > 0)
+    {
+        if (worker.queue.pop(&splitPoint, task) || stealTask(&splitPoint, worker, task))
+            searchTask(task, worker);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void AlphaBeta::searchTask(Task const & task, Worker & worker)
+{
+    SplitPoint & splitPoint = *task.splitPoint;
+    if (stopped(&splitPoint))
+    {
+        ++worker.statistics.abandoned;
+    }
+    else
+    {
+        ++worker.statistics.tasks;
+        if (splitPoint.owner != worker.id)
+            ++worker.statistics.steals;
+
+        float  alpha;
+        size_t bestIndex;
+        {
+            std::lock_guard<std::mutex> lock(splitPoint.mutex);
+            alpha     = splitPoint.alpha;
+            bestIndex = splitPoint.bestIndex;
+        }
+
+        // A move that comes before the best move so far is chosen if its value is equal, so its window must include
+        // that value.
+        size_t index = splitPoint.first + task.index;
+        if (index < bestIndex)
+            alpha = std::nextafter(alpha, -INFINITE_VALUE);
+
+        // The owner is waiting at the split point, so it searches in its own state. Any other thread searches in its
+        // own copy of the state.
+        Move const & move = splitPoint.moves[task.index];
+        float        value;
+        if (splitPoint.owner == worker.id)
+        {
+            value = searchChild(splitPoint.ownerState,
+                                move,
+                                index,
+                                splitPoint.depth,
+                                alpha,
+                                splitPoint.beta,
+                                splitPoint.ply,
+                                &splitPoint,
+                                worker);
+        }
+        else
+        {
+            GameState state(splitPoint.state);
+            value = searchChild(state,
+                                move,
+                                index,
+                                splitPoint.depth,
+                                alpha,
+                                splitPoint.beta,
+                                splitPoint.ply,
+                                &splitPoint,
+                                worker);
+        }
+
+        if (!stopped(&splitPoint))
+        {
+            std::lock_guard<std::mutex> lock(splitPoint.mutex);
+            if (value > splitPoint.best || (value == splitPoint.best && index < splitPoint.bestIndex))
+            {
+                splitPoint.best      = value;
+                splitPoint.bestIndex = index;
+                splitPoint.bestMove  = move;
+                splitPoint.alpha     = std::max(splitPoint.alpha, value);
+                if (splitPoint.alpha >= splitPoint.beta)
+                {
+                    splitPoint.cutoff = true;
+                    ++worker.statistics.splitCutoffs;
+                    ++worker.statistics.cutoffs;
+                    worker.ordering.recordCutoff(splitPoint.state, move, splitPoint.depth, splitPoint.ply + 1);
+                }
+            }
+        }
+    }
+
+    // This must be the last access to the split point, since the owner may return as soon as there are no pending
+    // tasks
+    --splitPoint.pending;
+}
+
+bool AlphaBeta::stealTask(SplitPoint const * splitPoint, Worker & worker, Task & task)
+{
+    for (int i = 1; i < threads_; ++i)
+    {
+        Worker & victim = *workers_[(worker.id + i) % threads_];
+        if (victim.queue.steal(splitPoint, task))
+            return true;
+    }
+    return false;
+}
+
+void AlphaBeta::idle(Worker & worker)
+{
+    Task task;
+    while (!done_)
+    {
+        if (stealTask(nullptr, worker, task))
+            searchTask(task, worker);
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool AlphaBeta::stopped(SplitPoint const * splitPoint) const
+{
+    if (abort_ && abort_->load(std::memory_order_relaxed))
+        return true;
+    for (; splitPoint; splitPoint = splitPoint->parent)
+    {
+        if (splitPoint->cutoff.load(std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,208 @@
+#if !defined(CHESS_ALPHABETA_H)
+#define CHESS_ALPHABETA_H
+
+#pragma once
+
+#include "Chess/HashMoveTable.h"
+#include "Chess/Move.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class GameState;
+class StagedMoveGenerator;
+class StaticEvaluator;
+
+// A fixed-depth alpha-beta search that runs on several threads by splitting the tree (Young Brothers Wait).
+//
+// The moves of a node come from StagedMoveGenerator and the leaves are valued by StaticEvaluator. The moves are legal
+// and generated in stages, so a node with no moves is checkmate or stalemate, and when an early move fails high, the
+// later moves are never generated.
+//
+// Beyond the fixed depth, a quiescence search follows captures and promotions until the position is quiet, so that a
+// leaf is never valued in the middle of an exchange. At each quiescence node, the player to move can "stand pat" and
+// take the static value instead of capturing. Captures that lose material by static exchange evaluation are not
+// searched.
+//
+// The search is selective. If passing (a null move) still fails high at a reduced depth, then the node is pruned.
+// When the player to move has few pieces, zugzwang makes that assumption unsafe, so the cutoff is verified by a
+// reduced search of the node itself. Late quiet moves are searched at a reduced depth (late move reductions), unless
+// they have a history of causing cutoffs, and are searched again at full depth if they turn out to be better than
+// expected.
+//
+// The best move found by an earlier search of a node (the hash move) is searched first. The threads share the hash
+// moves through a lock-free HashMoveTable, which persists between searches, so each iteration of an iteratively
+// deepening search orders its moves by the results of the previous one. The remaining moves are ordered by each
+// thread's MoveOrdering tables: captures that don't lose material, then killer moves, the countermove, other quiet
+// moves by their history, and finally the captures that lose material. The tables are updated whenever a move fails
+// high. The moves at the root are ordered the same way regardless of the tables, with the best move of the previous
+// search of the root first.
+//
+// The first move of a node (the eldest brother) is always searched by the thread that owns the node. Once it is done,
+// the node becomes a split point and each of the remaining moves becomes a task on the owner's work queue.
+// Idle threads steal tasks from the front of the other threads' queues, and the owner takes tasks from the back of
+// its own. While the owner waits for stolen tasks to finish, it only helps with tasks below its own split point. If
+// a move fails high, the split point's remaining tasks are abandoned.
+//
+// Without the selective search, the value found at a given depth does not depend on the number of threads. Among
+// moves with equal values, the one generated first is chosen, as a single thread would. The selective search depends
+// on the bounds that a thread sees and on its history, so with it, the value can vary with the number of threads. So
+// unless the options are given explicitly, the selective search is only used with one thread, trading depth for
+// results that are reproducible.
+class AlphaBeta
+{
+public:
+    // Counts of the work done by a search, summed over all threads
+    struct Statistics
+    {
+        uint64_t nodes               = 0;   // Nodes searched, not including the quiescence search
+        uint64_t qnodes              = 0;   // Nodes searched by the quiescence search
+        uint64_t splits              = 0;   // Nodes that became split points
+        uint64_t tasks               = 0;   // Tasks searched
+        uint64_t steals              = 0;   // Tasks searched by a thread other than the owner of the split point
+        uint64_t abandoned           = 0;   // Tasks not searched because of a cutoff
+        uint64_t splitCutoffs        = 0;   // Split points where a task failed high
+        uint64_t nullMoveCutoffs     = 0;   // Nodes pruned by a null move
+        uint64_t failedVerifications = 0;   // Null-move cutoffs that were not confirmed by the verification search
+        uint64_t reductions          = 0;   // Moves searched at a reduced depth
+        uint64_t researches          = 0;   // Reduced moves searched again at full depth
+        uint64_t cutoffs             = 0;   // Nodes where a move failed high
+        uint64_t firstMoveCutoffs    = 0;   // Nodes where the first move failed high
+        uint64_t seePrunes           = 0;   // Captures not searched by the quiescence search because they lose material
+
+        Statistics & operator +=(Statistics const & other);
+    };
+
+    // Parameters of the selective search
+    struct Options
+    {
+        int nullMoveReduction = 2;  // Depth reduction of the null-move search (0 disables null-move pruning)
+        int nullMoveMinDepth  = 3;  // Null moves are only tried with at least this much depth left
+        int verifyPieces      = 2;  // Null-move cutoffs are verified if the player has this many pieces or fewer
+                                    // (not counting the king and pawns)
+        int lmrMinMoves       = 4;  // Number of moves searched at full depth before reducing (0 disables reductions)
+        int lmrMinDepth       = 3;  // Moves are only reduced with at least this much depth left
+        int lmrHistory        = 16; // Moves with at least this history score are reduced one ply less
+
+        // Returns options that turn off the selective search, so that every move is searched to the full depth
+        static Options exact();
+    };
+
+    // Constructor. If threads is 0, the number of hardware threads is used. Nodes with less than minSplitDepth plies
+    // left to search are never split. Without options, the selective search is used only if there is one thread.
+    AlphaBeta(std::shared_ptr<StaticEvaluator> evaluator, int threads = 1, int minSplitDepth = 2);
+    AlphaBeta(std::shared_ptr<StaticEvaluator> evaluator, int threads, int minSplitDepth, Options const & options);
+
+    // Destructor
+    ~AlphaBeta();
+
+    // Searches to the given depth and returns the best response, or nullptr if there are no legal moves or the search
+    // was aborted. If abort is not null, the search stops as soon as it is set. If value is not null, the value of the
+    // state (from the point of view of the player to move) is returned in it.
+    std::shared_ptr<GameState> search(GameState const &         state,
+                                      int                       depth,
+                                      std::atomic<bool> const * abort = nullptr,
+                                      float *                   value = nullptr);
+
+    // Returns the number of threads used
+    int threads() const { return threads_; }
+
+    // Returns the counts of the work done since the last reset
+    Statistics const & statistics() const { return statistics_; }
+
+    // Resets the counts
+    void resetStatistics() { statistics_ = Statistics(); }
+
+private:
+    struct SplitPoint;
+    struct Worker;
+
+    // A remaining child of a split point
+    struct Task
+    {
+        SplitPoint * splitPoint;
+        size_t       index;
+    };
+
+    // A queue of tasks. The owner pushes and pops at the back and the other threads steal from the front.
+    class WorkQueue
+    {
+    public:
+        void push(Task const & task);
+
+        // Removes the last task if it belongs to the split point or one of its descendants
+        bool pop(SplitPoint const * splitPoint, Task & task);
+
+        // Removes the first task that belongs to the split point or one of its descendants (or any task if the split
+        // point is null)
+        bool steal(SplitPoint const * splitPoint, Task & task);
+
+    private:
+        std::mutex       mutex_;
+        std::deque<Task> tasks_;
+    };
+
+    // The private search functions make and unmake moves in the state, so it is the same when they return
+    float search(GameState &  state,
+                 int          depth,
+                 float        alpha,
+                 float        beta,
+                 int          ply,
+                 SplitPoint * parent,
+                 Worker &     worker,
+                 bool         nullMoveAllowed = true);
+    bool  nullMoveFailsHigh(GameState &  state,
+                            int          depth,
+                            float        beta,
+                            int          ply,
+                            SplitPoint * parent,
+                            Worker &     worker);
+    float searchChild(GameState &  state,
+                      Move const & move,
+                      size_t       index,
+                      int          depth,
+                      float        alpha,
+                      float        beta,
+                      int          ply,
+                      SplitPoint * parent,
+                      Worker &     worker);
+    float searchMoves(GameState &           state,
+                      StagedMoveGenerator & moves,
+                      int                   depth,
+                      float                 alpha,
+                      float                 beta,
+                      int                   ply,
+                      SplitPoint *          parent,
+                      Worker &              worker,
+                      Move &                bestMove);
+    float quiesce(GameState &  state,
+                  float        alpha,
+                  float        beta,
+                  int          ply,
+                  SplitPoint * parent,
+                  Worker &     worker);
+    float evaluate(GameState const & state) const;
+    void  split(SplitPoint & splitPoint, Worker & worker);
+    void  searchTask(Task const & task, Worker & worker);
+    bool  stealTask(SplitPoint const * splitPoint, Worker & worker, Task & task);
+    void  idle(Worker & worker);
+    bool  stopped(SplitPoint const * splitPoint) const;
+
+    std::shared_ptr<StaticEvaluator>     evaluator_;
+    int                                  threads_;
+    int                                  minSplitDepth_;
+    Options                              options_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    HashMoveTable                        hashMoves_;
+    std::atomic<bool> const *            abort_ = nullptr;
+    std::atomic<bool>                    done_;                // Set when the root has been searched
+    uint64_t                             rootFingerprint_ = 0; // Fingerprint of the root of the previous search
+    Move                                 rootBest_;            // Best move of the previous search
+    Statistics                           statistics_;
+};
+
+#endif // !defined(CHESS_ALPHABETA_H)
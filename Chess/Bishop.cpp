@@ -3,38 +3,22 @@
 #include "Board.h"
 #include "GameState.h"
 #include "Move.h"
+#include "PieceMoves.h"
 #include "Types.h"
 
 void Bishop::generatePossibleMoves(GameState const & state, Position const & from, MoveList & moves) const
 {
-    Board const & board = state.board_;
-    moves.reserve(moves.size() + MAX_POSSIBLE_MOVES);
-    generateSpanMoves(board, from, (int)Direction::UP, (int)Direction::RIGHT, moves);
-    generateSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::RIGHT, moves);
-    generateSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::LEFT, moves);
-    generateSpanMoves(board, from, (int)Direction::UP, (int)Direction::LEFT, moves);
+    PieceMoves::generate<PieceTypeId::BISHOP>(state.board_, this, from, moves);
 }
 
 int Bishop::countPossibleMoves(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-    count += countSpanMoves(board, from, (int)Direction::UP, (int)Direction::RIGHT);
-    count += countSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::RIGHT);
-    count += countSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::LEFT);
-    count += countSpanMoves(board, from, (int)Direction::UP, (int)Direction::LEFT);
-    return count;
+    return PieceMoves::count<PieceTypeId::BISHOP>(state.board_, color_, from);
 }
 
 int Bishop::countThreats(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-    count += countSpanThreats(board, from, (int)Direction::UP, (int)Direction::RIGHT);
-    count += countSpanThreats(board, from, (int)Direction::DOWN, (int)Direction::RIGHT);
-    count += countSpanThreats(board, from, (int)Direction::DOWN, (int)Direction::LEFT);
-    count += countSpanThreats(board, from, (int)Direction::UP, (int)Direction::LEFT);
-    return count;
+    return PieceMoves::countThreats<PieceTypeId::BISHOP>(state.board_, from);
 }
 
 bool Bishop::isValidMove(GameState const & state, Move const & move) const
@@ -132,74 +132,83 @@ bool Board::initializeFromFen(char const * start, char const * end)
 
 bool Board::isValidPosition(Position const & p)
 {
-    return p.row >= 0 &&
-           p.row < SIZE &&
-           p.column >= 0 &&
-           p.column < SIZE;
+    return (unsigned)p.row < (unsigned)SIZE && (unsigned)p.column < (unsigned)SIZE;
 }
 
-Piece const * Board::pieceAt(Position const & p) const
+void Board::putPiece(Piece const * piece, Position const & p)
 {
-    return pieceAt(p.row, p.column);
+    setPiece(piece, Square(p));
 }
 
-Piece const * Board::pieceAt(int r, int c) const
+void Board::putPiece(Piece const * piece, int r, int c)
 {
-    return board_[r][c];
+    setPiece(piece, Square(r, c));
 }
 
-void Board::putPiece(Piece const * piece, Position const & p)
+void Board::setPiece(Piece const * piece, Square s)
 {
-    putPiece(piece, p.row, p.column);
+    Piece const *& square = board_[s.index()];
+    if (square)
+        removeOccupancy(square, s);
+    square = piece;
+    if (piece)
+        addOccupancy(piece, s);
 }
 
-void Board::putPiece(Piece const * piece, int r, int c)
+void Board::removePiece(Position const & p)
 {
-    board_[r][c] = piece;
+    clearPiece(Square(p));
 }
 
-void Board::removePiece(Position const & p)
+void Board::removePiece(int r, int c)
 {
-    removePiece(p.row, p.column);
+    clearPiece(Square(r, c));
 }
 
-void Board::removePiece(int r, int c)
+void Board::clearPiece(Square s)
 {
-    board_[r][c] = NO_PIECE;
+    Piece const *& square = board_[s.index()];
+    if (square)
+        removeOccupancy(square, s);
+    square = NO_PIECE;
 }
 
 void Board::movePiece(Position const & from, Position const & to)
 {
-    board_[to.row][to.column]     = board_[from.row][from.column];
-    board_[from.row][from.column] = NO_PIECE;
+    Square        f(from);
+    Square        t(to);
+    Piece const * piece = board_[f.index()];
+    clearPiece(t);
+    if (piece)
+    {
+        removeOccupancy(piece, f);
+        addOccupancy(piece, t);
+    }
+    board_[t.index()] = piece;
+    board_[f.index()] = NO_PIECE;
 }
 
-bool Board::spanIsEmpty(Position const & from, Position const & to) const
+Position Board::kingPosition(Color color) const
 {
-    // Get the distance in rows and columns of the move (sign determines direction)
-    int row_move    = to.row - from.row;
-    int column_move = to.column - from.column;
-
-    // Determine the row and column increment for each square tested. If the distance moved in a direction is < 0,
-    // the increment is -1, if the distance is > 0, then the increment is 1, otherwise the increment is 0.
-    int row_delta    = (row_move < 0) ? -1 : (row_move == 0) ? 0 : 1;
-    int column_delta = (column_move < 0) ? -1 : (column_move == 0) ? 0 : 1;
-
-    // Determine the number of squares moved (excluding the last square)
-    int distance = std::max(abs(row_move), abs(column_move)) - 1;
+    return kingSquare(color).position();
+}
 
-    // Check every square except the first and last ones. If there is a piece occupying a square, then return false.
-    Position p = from;
-    for (int i = 0; i < distance; ++i)
-    {
-        p.row    += row_delta;
-        p.column += column_delta;
+Square Board::kingSquare(Color color) const
+{
+    int i;
+    return pieces(PieceTypeId::KING, color).first(i) ? Square(i) : Square();
+}
 
-        if (pieceAt(p))
-            return false;
-    }
+bool Board::isOccupied(Position const & p) const
+{
+    return isOccupied(p.row, p.column);
+}
 
-    return true;
+bool Board::spanIsEmpty(Position const & from, Position const & to) const
+{
+    // The span is empty if none of the squares between 'from' and 'to' are occupied
+    BitBoard span = BitBoard::between(from.row, from.column, to.row, to.column);
+    return (uint64_t(span) & uint64_t(occupied())) == 0;
 }
 
 std::string Board::fen() const
@@ -212,7 +221,7 @@ std::string Board::fen() const
         int span = 0;
         for (int column = 0; column < SIZE; ++column)
         {
-            Piece const * piece = board_[row][column];
+            Piece const * piece = pieceAt(row, column);
             if (piece == NO_PIECE)
             {
                 ++span;
@@ -237,6 +246,25 @@ void Board::clear()
 {
     assert(NO_PIECE == 0);
     memset(board_, 0, sizeof board_);
+    std::fill(std::begin(occupiedByColor_), std::end(occupiedByColor_), BitBoard());
+    for (auto & pieces : occupiedByPiece_)
+    {
+        std::fill(std::begin(pieces), std::end(pieces), BitBoard());
+    }
+}
+
+void Board::addOccupancy(Piece const * piece, Square s)
+{
+    int color = (int)piece->color();
+    occupiedByColor_[color].set(s.index());
+    occupiedByPiece_[color][(int)piece->type()].set(s.index());
+}
+
+void Board::removeOccupancy(Piece const * piece, Square s)
+{
+    int color = (int)piece->color();
+    occupiedByColor_[color].clear(s.index());
+    occupiedByPiece_[color][(int)piece->type()].clear(s.index());
 }
 
 bool operator ==(Board const & x, Board const & y)
@@ -3,11 +3,12 @@
 
 #pragma once
 
+#include "BitBoard/BitBoard.h"
+#include "Chess/Square.h"
 #include "Chess/Types.h"
 #include <string>
 
 class Piece;
-struct Position;
 
 class Board
 {
@@ -26,8 +27,9 @@ public:
     static bool isValidPosition(Position const & p);
 
     // Returns the piece at the given position or NO_PIECE, if none
-    Piece const * pieceAt(Position const & p) const;
-    Piece const * pieceAt(int r, int c) const;
+    Piece const * pieceAt(Position const & p) const { return pieceAt(p.row, p.column); }
+    Piece const * pieceAt(int r, int c) const { return board_[r * SIZE + c]; }
+    Piece const * pieceAt(Square s) const { return board_[s.index()]; }
 
     // Places the piece on the board at the given position
     void putPiece(Piece const * piece, Position const & to);
@@ -40,6 +42,26 @@ public:
     // Moves the piece at 'from' to 'to' (does not check legality)
     void movePiece(Position const & from, Position const & to);
 
+    // Returns the squares occupied by any piece
+    BitBoard occupied() const { return BitBoard(uint64_t(occupiedByColor_[0]) | uint64_t(occupiedByColor_[1])); }
+
+    // Returns the squares occupied by pieces of the given color
+    BitBoard occupied(Color color) const { return occupiedByColor_[(int)color]; }
+
+    // Returns the squares occupied by pieces of the given type and color
+    BitBoard pieces(PieceTypeId type, Color color) const { return occupiedByPiece_[(int)color][(int)type]; }
+
+    // Returns the position of the king of the given color, or an invalid position if there is none
+    Position kingPosition(Color color) const;
+
+    // Returns the square of the king of the given color, or an invalid square if there is none
+    Square kingSquare(Color color) const;
+
+    // Returns true if the given position is occupied by any piece
+    bool isOccupied(Position const & p) const;
+    bool isOccupied(int r, int c) const { return occupied().test(r, c) != 0; }
+    bool isOccupied(Square s) const { return occupied().test(s.index()) != 0; }
+
     // Returns true if the span from 'from' to 'to' (excluding 'from' and 'to') contains no pieces
     bool spanIsEmpty(Position const & from, Position const & to) const;
 
@@ -70,7 +92,21 @@ private:
     // Remove all pieces from the board
     void clear();
 
-    Piece const * board_[SIZE][SIZE]; // The board
+    // Places the piece on the board at the given square
+    void setPiece(Piece const * piece, Square s);
+
+    // Removes the piece at the given square from the board
+    void clearPiece(Square s);
+
+    // Adds the piece to the occupancy sets
+    void addOccupancy(Piece const * piece, Square s);
+
+    // Removes the piece from the occupancy sets
+    void removeOccupancy(Piece const * piece, Square s);
+
+    Piece const * board_[SIZE * SIZE];                                  // The board, indexed by square
+    BitBoard occupiedByColor_[NUMBER_OF_COLORS];                        // Squares occupied by each color
+    BitBoard occupiedByPiece_[NUMBER_OF_COLORS][NUMBER_OF_PIECE_TYPES]; // Squares occupied by each type of piece
 };
 
 // Returns true if the other board is the same as this one
@@ -13,10 +13,43 @@
 #include <Misc/Etc.h>
 #include <Misc/Exceptions.h>
 #include <nlohmann/json.hpp>
+#include <cstdlib>
 #include <regex>
 
 using json = nlohmann::json;
 
+namespace
+{
+#if !defined(FEATURE_BITBOARD_THREAT_DETECTION)
+
+// Returns true if the first piece found from 'p' in the given direction is one of the given types and the given color
+bool rayIsAttacked(Board const & board, Position const & p, int dr, int dc, PieceTypeId type1, PieceTypeId type2, Color byColor)
+{
+    Position to(p.row + dr, p.column + dc);
+    while (Board::isValidPosition(to))
+    {
+        Piece const * piece = board.pieceAt(to);
+        if (piece)
+            return piece->color() == byColor && (piece->type() == type1 || piece->type() == type2);
+        to.row    += dr;
+        to.column += dc;
+    }
+    return false;
+}
+
+// Returns true if the piece at 'p' + (dr, dc) is the given type and color
+bool squareIsAttacked(Board const & board, Position const & p, int dr, int dc, PieceTypeId type, Color byColor)
+{
+    Position to(p.row + dr, p.column + dc);
+    if (!Board::isValidPosition(to))
+        return false;
+    Piece const * piece = board.pieceAt(to);
+    return piece && piece->color() == byColor && piece->type() == type;
+}
+
+#endif // !defined(FEATURE_BITBOARD_THREAT_DETECTION)
+} // anonymous namespace
+
 GameState::GameState(Board const & board,
                      Color         who,
                      CastleStatus  castleStatus,
@@ -31,20 +64,22 @@ GameState::GameState(Board const & board,
     , move_(move)
     , inCheck_(inCheck)
     , moveNumber_(moveNumber)
-    , zhash_(board, who, castleStatus)  // @todo this is not correct because en passant and the fifty-move timer are part of the state, too
+    , zhash_(board, who, castleStatus, Color::INVALID, -1, fiftyMoveTimer >= FIFTY_MOVE_RULE_LIMIT)
 {
 }
 
 void GameState::initialize()
 {
     board_.initialize();
-    whoseTurn_      = Color::WHITE;
-    castleStatus_   = 0;
-    fiftyMoveTimer_ = 0;
-    makeMove(Move::reset());
-    inCheck_    = false;
-    moveNumber_ = 1;
-    zhash_      = ZHash(board_, whoseTurn_);
+    whoseTurn_       = Color::WHITE;
+    castleStatus_    = 0;
+    fiftyMoveTimer_  = 0;
+    enPassant_       = Square();
+    move_            = Move::reset();
+    inCheck_         = false;
+    moveNumber_      = 1;
+    zhash_           = ZHash(board_, whoseTurn_);
+    attackInfoValid_ = 0;
 }
 
 bool GameState::initializeFromFen(char const * fen)
@@ -52,6 +87,8 @@ bool GameState::initializeFromFen(char const * fen)
     char const * start = fen;
     char const * end   = start;
 
+    attackInfoValid_ = 0;
+
     // Extract the piece placement field
     end = strchr(start, ' ');
     if (!end || !board_.initializeFromFen(start, end))
@@ -73,8 +110,9 @@ bool GameState::initializeFromFen(char const * fen)
     // Extract the en passant target square
     Position enpassant;
     end = strchr(start, ' ');
-    if (!end || !enpassant.initializeFromFen(start, end))
+    if (!end || !(std::string(start, end) == "-" || enpassant.initializeFromFen(start, end)))
         return false;
+    enPassant_ = enpassant;
     start = end + 1;
 
     // Extract the fifty-move rule timer
@@ -88,8 +126,14 @@ bool GameState::initializeFromFen(char const * fen)
     if (!end || !moveNumberFromFen(start, end))
         return false;
 
-    inCheck_ = false;   // @todo See issue #25.
-    zhash_   = ZHash(board_, whoseTurn_);
+    move_    = Move::reset();
+    inCheck_ = !checkInfo().checkers_.empty();
+    zhash_   = ZHash(board_,
+                     whoseTurn_,
+                     castleStatus_,
+                     enPassant_.isValid() ? whoseTurn_ : Color::INVALID,
+                     enPassant_.column(),
+                     fiftyMoveTimer_ >= FIFTY_MOVE_RULE_LIMIT);
 
     return true;
 }
@@ -114,8 +158,208 @@ bool GameState::queenSideCastleIsAllowed(Color c) const
 
 bool GameState::canBeOccupied(Position const & p, Color myColor) const
 {
-    Piece const * piece = board_.pieceAt(p);
-    return (piece == NO_PIECE) || (piece->color() != myColor);
+    return board_.occupied(myColor).test(p.row, p.column) == 0;
+}
+
+bool GameState::isAttacked(Position const & p, Color byColor) const
+{
+#if defined(FEATURE_BITBOARD_THREAT_DETECTION)
+    return !attackersTo(p, byColor).empty();
+#else
+    // Look for a piece attacking the position by checking each direction it can be attacked from
+    static int const KNIGHT_OFFSETS[][2] = { { -2, -1 }, { -2, 1 }, { -1, 2 }, { 1, 2 }, { 2, 1 }, { 2, -1 }, { 1, -2 }, { -1, -2 } };
+    static int const KING_OFFSETS[][2]   = { { -1, -1 }, { -1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 } };
+
+    for (auto const & o : KING_OFFSETS)
+    {
+        bool diagonal = (o[0] != 0) && (o[1] != 0);
+        PieceTypeId slider = diagonal ? PieceTypeId::BISHOP : PieceTypeId::ROOK;
+        if (rayIsAttacked(board_, p, o[0], o[1], slider, PieceTypeId::QUEEN, byColor) ||
+            squareIsAttacked(board_, p, o[0], o[1], PieceTypeId::KING, byColor))
+        {
+            return true;
+        }
+    }
+
+    for (auto const & o : KNIGHT_OFFSETS)
+    {
+        if (squareIsAttacked(board_, p, o[0], o[1], PieceTypeId::KNIGHT, byColor))
+            return true;
+    }
+
+    // A white pawn attacks from the row below and a black pawn attacks from the row above
+    int pawnRow = (byColor == Color::WHITE) ? (int)Direction::DOWN : (int)Direction::UP;
+    return squareIsAttacked(board_, p, pawnRow, (int)Direction::LEFT, PieceTypeId::PAWN, byColor) ||
+           squareIsAttacked(board_, p, pawnRow, (int)Direction::RIGHT, PieceTypeId::PAWN, byColor);
+#endif // defined(FEATURE_BITBOARD_THREAT_DETECTION)
+}
+
+BitBoard GameState::attackersTo(Position const & p) const
+{
+    return BitBoard(uint64_t(attackersTo(p, Color::WHITE)) | uint64_t(attackersTo(p, Color::BLACK)));
+}
+
+BitBoard GameState::attackersTo(Position const & p, Color byColor) const
+{
+    return attackersTo(p, byColor, board_.occupied());
+}
+
+BitBoard GameState::attackersTo(Position const & p, Color byColor, BitBoard const & occupied) const
+{
+    uint64_t queens   = board_.pieces(PieceTypeId::QUEEN, byColor);
+    uint64_t rooks    = board_.pieces(PieceTypeId::ROOK, byColor);
+    uint64_t bishops  = board_.pieces(PieceTypeId::BISHOP, byColor);
+    uint64_t knights  = board_.pieces(PieceTypeId::KNIGHT, byColor);
+    uint64_t kings    = board_.pieces(PieceTypeId::KING, byColor);
+    uint64_t pawns    = board_.pieces(PieceTypeId::PAWN, byColor);
+
+    // A piece attacks the position if the same kind of piece at the position would attack it. Pawns are the exception
+    // because their attacks depend on their color.
+    Color    opponent = (byColor == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    int      square   = p.row * Board::SIZE + p.column;
+
+    uint64_t attackers = 0;
+    attackers |= uint64_t(BitBoard::slidingAttacks(BitBoard::ROOK, p.row, p.column, occupied)) & (rooks | queens);
+    attackers |= uint64_t(BitBoard::slidingAttacks(BitBoard::BISHOP, p.row, p.column, occupied)) & (bishops | queens);
+    attackers |= uint64_t(BitBoard::threatened(BitBoard::KNIGHT, p.row, p.column)) & knights;
+    attackers |= uint64_t(BitBoard::threatened(BitBoard::KING, p.row, p.column)) & kings;
+    attackers |= uint64_t(BitBoard::pawnThreatened((BitBoard::PawnColor)opponent, square)) & pawns;
+
+    return BitBoard(attackers);
+}
+
+BitBoard GameState::attackedSquares(Color byColor, BitBoard const & occupied) const
+{
+    uint64_t queens  = board_.pieces(PieceTypeId::QUEEN, byColor);
+    uint64_t rooks   = board_.pieces(PieceTypeId::ROOK, byColor);
+    uint64_t bishops = board_.pieces(PieceTypeId::BISHOP, byColor);
+
+    // The attacks of all the sliding pieces are filled at once, and the pawns are shifted all at once
+    uint64_t attacked = BitBoard::slidingAttacksFill(BitBoard(rooks | queens), BitBoard(bishops | queens), occupied);
+    attacked |= BitBoard::pawnAttacks((BitBoard::PawnColor)byColor, board_.pieces(PieceTypeId::PAWN, byColor));
+    for (int i : board_.pieces(PieceTypeId::KNIGHT, byColor))
+    {
+        attacked |= BitBoard::threatened(BitBoard::KNIGHT, i);
+    }
+    for (int i : board_.pieces(PieceTypeId::KING, byColor))
+    {
+        attacked |= BitBoard::threatened(BitBoard::KING, i);
+    }
+
+    return BitBoard(attacked);
+}
+
+void GameState::computeAttacks() const
+{
+    AttackInfo & info     = attackInfo_;
+    BitBoard     occupied = board_.occupied();
+
+    // The attacks of each piece are found once, and they are combined by type and by side and counted for the
+    // evaluation of mobility and threats
+    for (Color color : { Color::WHITE, Color::BLACK })
+    {
+        int      c        = (int)color;
+        uint64_t ours     = board_.occupied(color);
+        uint64_t bySide   = 0;
+        int      mobility = 0;
+        int      threats  = 0;
+
+        for (PieceTypeId type : { PieceTypeId::QUEEN, PieceTypeId::ROOK, PieceTypeId::BISHOP, PieceTypeId::KNIGHT })
+        {
+            uint64_t byType = 0;
+            for (int i : board_.pieces(type, color))
+            {
+                uint64_t attacks = (type == PieceTypeId::KNIGHT) ? uint64_t(BitBoard::threatened(BitBoard::KNIGHT, i))
+                                                                 : uint64_t(BitBoard::slidingAttacks((int)type, i, occupied));
+                byType   |= attacks;
+                mobility += BitBoard(attacks & ~ours).count();
+                threats  += BitBoard(attacks & occupied).count();
+            }
+            info.byType_[c][(int)type] = BitBoard(byType);
+            bySide |= byType;
+        }
+
+        uint64_t kings = 0;
+        for (int i : board_.pieces(PieceTypeId::KING, color))
+        {
+            uint64_t attacks = BitBoard::threatened(BitBoard::KING, i);
+            kings   |= attacks;
+            threats += BitBoard(attacks & occupied).count();
+        }
+        info.byType_[c][(int)PieceTypeId::KING] = BitBoard(kings);
+
+        // Each pawn attacks in both directions, so the directions are counted separately
+        BitBoard::PawnColor pawnColor = (BitBoard::PawnColor)color;
+        BitBoard            pawns     = board_.pieces(PieceTypeId::PAWN, color);
+        uint64_t            left      = BitBoard::pawnAttacksLeft(pawnColor, pawns);
+        uint64_t            right     = BitBoard::pawnAttacksRight(pawnColor, pawns);
+        threats += BitBoard(left & occupied).count() + BitBoard(right & occupied).count();
+        info.byType_[c][(int)PieceTypeId::PAWN] = BitBoard(left | right);
+
+        info.bySide_[c]   = BitBoard(bySide | kings | left | right);
+        info.mobility_[c] = mobility;
+        info.threats_[c]  = threats;
+    }
+
+    attackInfoValid_ |= ATTACKS_VALID;
+}
+
+void GameState::computeChecks() const
+{
+    AttackInfo & info     = attackInfo_;
+    BitBoard     occupied = board_.occupied();
+    Color        them     = (whoseTurn_ == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    Square       king     = board_.kingSquare(whoseTurn_);
+    uint64_t     queens   = board_.pieces(PieceTypeId::QUEEN, them);
+    uint64_t     rooks    = board_.pieces(PieceTypeId::ROOK, them);
+    uint64_t     bishops  = board_.pieces(PieceTypeId::BISHOP, them);
+
+    info.checkers_ = BitBoard();
+    info.pinned_   = BitBoard();
+    info.pinners_  = BitBoard();
+
+    // Without a king, there are no checks or pins
+    if (!king.isValid())
+    {
+        info.kingDanger_ = attackedSquares(them, occupied);
+        attackInfoValid_ |= CHECKS_VALID;
+        return;
+    }
+
+    info.checkers_ = attackersTo(king.position(), them);
+
+    // Any enemy slider that would attack the king on an empty board pins one of our pieces if that piece is the only
+    // piece between them
+    uint64_t ours = board_.occupied(whoseTurn_);
+    BitBoard snipers((uint64_t(BitBoard::threatened(BitBoard::ROOK, king.index())) & (rooks | queens)) |
+                     (uint64_t(BitBoard::threatened(BitBoard::BISHOP, king.index())) & (bishops | queens)));
+    uint64_t pinned  = 0;
+    uint64_t pinners = 0;
+    for (int i : snipers)
+    {
+        uint64_t blockers = uint64_t(BitBoard::between(king.index(), i)) & occupied;
+        if (BitBoard(blockers).count() == 1 && (blockers & ours))
+        {
+            pinned  |= blockers;
+            pinners |= uint64_t(1) << i;
+        }
+    }
+    info.pinned_  = BitBoard(pinned);
+    info.pinners_ = BitBoard(pinners);
+
+    // The king can't escape a slider by moving away from it along the line of attack, so the attacks are found with
+    // the king removed
+    info.kingDanger_ = attackedSquares(them, BitBoard(uint64_t(occupied) & ~(uint64_t(1) << king.index())));
+
+    attackInfoValid_ |= CHECKS_VALID;
+}
+
+bool GameState::kingIsAttacked(Color c) const
+{
+    Position king = board_.kingPosition(c);
+    if (!Board::isValidPosition(king))
+        return false;
+    return isAttacked(king, (c == Color::WHITE) ? Color::BLACK : Color::WHITE);
 }
 
 ZHash GameState::zhash() const
@@ -125,8 +369,44 @@ ZHash GameState::zhash() const
 
 void GameState::makeMove(Move const & move)
 {
+    applyMove(move);
+}
+
+void GameState::makeMove(Move const & move, UndoInfo & undo)
+{
+    // Save the parts of the state that can't be recovered from the move
+    undo.castleStatus_    = castleStatus_;
+    undo.enPassant_       = enPassant_;
+    undo.fiftyMoveTimer_  = fiftyMoveTimer_;
+    undo.move_            = move_;
+    undo.inCheck_         = inCheck_;
+    undo.zhash_           = zhash_;
+    undo.attackInfoValid_ = attackInfoValid_;
+    if (attackInfoValid_)
+        undo.attackInfo_ = attackInfo_;
+#if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
+    undo.value_ = value_;
+#endif
+
+    undo.capturedPiece_ = applyMove(move);
+}
+
+Piece const * GameState::applyMove(Move const & move)
+{
+    CastleStatus  oldCastleStatus   = castleStatus_;
+    int           oldFiftyMoveTimer = fiftyMoveTimer_;
+    Piece const * capturedPiece     = NO_PIECE;
+
     // Save the move
-    move_ = move;
+    attackInfoValid_ = 0;
+    move_            = move;
+
+    // Any en passant opportunity is lost after this move
+    if (enPassant_.isValid())
+    {
+        zhash_.enPassant(whoseTurn_, enPassant_.column());
+        enPassant_ = Square();
+    }
 
     // These special moves don't do anything
     if (move.isResignation() || move.isUndo() || move.isStartingPosition())
@@ -138,14 +418,20 @@ void GameState::makeMove(Move const & move)
     else if (move.isKingSideCastle() || move.isQueenSideCastle())
     {
         makeCastleMove(move);
+        ++fiftyMoveTimer_;
     }
 
     // Normal move
     else
     {
-        makeNormalMove(move);
+        capturedPiece = makeNormalMove(move);
     }
 
+    // Update the hash with any changes in castle availability and the fifty-move rule
+    zhash_.castleAvailability((oldCastleStatus ^ castleStatus_) & CASTLE_AVAILABILITY_MASK);
+    if ((oldFiftyMoveTimer >= FIFTY_MOVE_RULE_LIMIT) != (fiftyMoveTimer_ >= FIFTY_MOVE_RULE_LIMIT))
+        zhash_.fifty();
+
     if (whoseTurn_ == Color::WHITE)
     {
         whoseTurn_ = Color::BLACK;
@@ -157,6 +443,119 @@ void GameState::makeMove(Move const & move)
     }
 
     zhash_.turn();
+
+    // The en passant opportunity (if any) belongs to the next player
+    if (enPassant_.isValid())
+        zhash_.enPassant(whoseTurn_, enPassant_.column());
+
+    // Update check status. The checks and pins are needed by whatever is done next with this state, so they are
+    // computed now.
+    inCheck_ = !checkInfo().checkers_.empty();
+    return capturedPiece;
+}
+
+void GameState::makeNullMove()
+{
+    attackInfoValid_ = 0;
+    move_            = Move();
+
+    if (enPassant_.isValid())
+    {
+        zhash_.enPassant(whoseTurn_, enPassant_.column());
+        enPassant_ = Square();
+    }
+
+    if (whoseTurn_ == Color::WHITE)
+    {
+        whoseTurn_ = Color::BLACK;
+    }
+    else
+    {
+        whoseTurn_ = Color::WHITE;
+        ++moveNumber_;
+    }
+    zhash_.turn();
+
+    inCheck_ = !checkInfo().checkers_.empty();
+}
+
+void GameState::makeNullMove(UndoInfo & undo)
+{
+    // Only the parts of the state that a null move changes are saved
+    undo.enPassant_       = enPassant_;
+    undo.move_            = move_;
+    undo.inCheck_         = inCheck_;
+    undo.zhash_           = zhash_;
+    undo.attackInfoValid_ = attackInfoValid_;
+    if (attackInfoValid_)
+        undo.attackInfo_ = attackInfo_;
+
+    makeNullMove();
+}
+
+void GameState::unmakeNullMove(UndoInfo const & undo)
+{
+    if (whoseTurn_ == Color::WHITE)
+    {
+        whoseTurn_ = Color::BLACK;
+        --moveNumber_;
+    }
+    else
+    {
+        whoseTurn_ = Color::WHITE;
+    }
+
+    enPassant_       = undo.enPassant_;
+    move_            = undo.move_;
+    inCheck_         = undo.inCheck_;
+    zhash_           = undo.zhash_;
+    attackInfoValid_ = undo.attackInfoValid_;
+    if (attackInfoValid_)
+        attackInfo_ = undo.attackInfo_;
+}
+
+void GameState::unmakeMove(Move const & move, UndoInfo const & undo)
+{
+    if (whoseTurn_ == Color::WHITE)
+    {
+        whoseTurn_ = Color::BLACK;
+        --moveNumber_;
+    }
+    else
+    {
+        whoseTurn_ = Color::WHITE;
+    }
+
+    // These special moves don't do anything
+    if (move.isResignation() || move.isUndo() || move.isStartingPosition())
+    {
+        // Do nothing
+    }
+
+    // Castle is a special case move. Handle it separately
+    else if (move.isKingSideCastle() || move.isQueenSideCastle())
+    {
+        unmakeCastleMove(move);
+    }
+
+    // Normal move
+    else
+    {
+        unmakeNormalMove(move, undo.capturedPiece_);
+    }
+
+    castleStatus_    = undo.castleStatus_;
+    enPassant_       = undo.enPassant_;
+    fiftyMoveTimer_  = undo.fiftyMoveTimer_;
+    move_            = undo.move_;
+    inCheck_         = undo.inCheck_;
+    zhash_           = undo.zhash_;
+    attackInfoValid_ = undo.attackInfoValid_;
+    if (attackInfoValid_)
+        attackInfo_ = undo.attackInfo_;
+#if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
+    value_ = undo.value_;
+#endif
 }
 
 std::string GameState::fen() const
@@ -178,7 +577,7 @@ std::string GameState::fen() const
     return result;
 }
 
-void GameState::makeNormalMove(Move const & move)
+Piece const * GameState::makeNormalMove(Move const & move)
 {
     Piece const * movedPiece = board_.pieceAt(move.from());
 
@@ -199,7 +598,7 @@ void GameState::makeNormalMove(Move const & move)
     Piece const * addedPiece;
 
     if (move.isPromotion())
-        addedPiece = promote(move.to());
+        addedPiece = promote(move.to(), move.promotedTo());
     else
         addedPiece = NO_PIECE;
 
@@ -209,29 +608,46 @@ void GameState::makeNormalMove(Move const & move)
     CastleStatus oldStatus = castleStatus_;
 #endif
 
+    // Note: a move can affect two castles (a rook capturing a rook), so each one is checked independently
     if (movedPiece->type() == PieceTypeId::KING)
         castleStatus_ |= (whoseTurn_ == Color::WHITE) ? WHITE_CASTLE_UNAVAILABLE : BLACK_CASTLE_UNAVAILABLE;
-    else if (move.from() == Board::INITIAL_WHITE_ROOK_QUEENSIDE_POSITION ||
-             move.to() == Board::INITIAL_WHITE_ROOK_QUEENSIDE_POSITION)
+    if (move.from() == Board::INITIAL_WHITE_ROOK_QUEENSIDE_POSITION ||
+        move.to() == Board::INITIAL_WHITE_ROOK_QUEENSIDE_POSITION)
         castleStatus_ |= WHITE_QUEENSIDE_CASTLE_UNAVAILABLE;
-    else if (move.from() == Board::INITIAL_WHITE_ROOK_KINGSIDE_POSITION || move.to() == Board::INITIAL_WHITE_ROOK_KINGSIDE_POSITION)
+    if (move.from() == Board::INITIAL_WHITE_ROOK_KINGSIDE_POSITION || move.to() == Board::INITIAL_WHITE_ROOK_KINGSIDE_POSITION)
         castleStatus_ |= WHITE_KINGSIDE_CASTLE_UNAVAILABLE;
-    else if (move.from() == Board::INITIAL_BLACK_ROOK_QUEENSIDE_POSITION ||
-             move.to() == Board::INITIAL_BLACK_ROOK_QUEENSIDE_POSITION)
+    if (move.from() == Board::INITIAL_BLACK_ROOK_QUEENSIDE_POSITION ||
+        move.to() == Board::INITIAL_BLACK_ROOK_QUEENSIDE_POSITION)
         castleStatus_ |= BLACK_QUEENSIDE_CASTLE_UNAVAILABLE;
-    else if (move.from() == Board::INITIAL_BLACK_ROOK_KINGSIDE_POSITION || move.to() == Board::INITIAL_BLACK_ROOK_KINGSIDE_POSITION)
+    if (move.from() == Board::INITIAL_BLACK_ROOK_KINGSIDE_POSITION || move.to() == Board::INITIAL_BLACK_ROOK_KINGSIDE_POSITION)
         castleStatus_ |= BLACK_KINGSIDE_CASTLE_UNAVAILABLE;
 
+    // Update the fifty-move rule timer and en passant. The timer is reset by a pawn move or a capture, and a pawn
+    // moving two squares can be captured en passant on the square it passed.
+    if (movedPiece->type() == PieceTypeId::PAWN)
+    {
+        fiftyMoveTimer_ = 0;
+        if (std::abs(move.to().row - move.from().row) == 2)
+            enPassant_ = Square((move.from().row + move.to().row) / 2, move.from().column);
+    }
+    else if (capturedPiece)
+    {
+        fiftyMoveTimer_ = 0;
+    }
+    else
+    {
+        ++fiftyMoveTimer_;
+    }
+
 #if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
     CastleStatus castleStatusChange = oldStatus ^ castleStatus_;
 #endif
 
-    // Update check status
-    // @todo check for in check
-
 #if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
     value_ += StaticEvaluator::incremental(move, castleStatusChange, movedPiece, &capturedPosition, capturedPiece, addedPiece);
 #endif
+
+    return capturedPiece;
 }
 
 void GameState::makeCastleMove(Move const & move)
@@ -276,15 +692,41 @@ void GameState::makeCastleMove(Move const & move)
     CastleStatus castleStatusChange = oldStatus ^ castleStatus_;
 #endif
 
-    // Update check status
-    // @todo check for in check
-
 #if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
     value_ += StaticEvaluator::incremental(move, castleStatusChange);
 #endif
 }
 
-Piece const * GameState::promote(Position const & position)
+void GameState::unmakeNormalMove(Move const & move, Piece const * capturedPiece)
+{
+    // Demote a promoted piece
+    if (move.isPromotion())
+    {
+        board_.removePiece(move.to());
+        board_.putPiece(Piece::get(PieceTypeId::PAWN, whoseTurn_), move.to());
+    }
+
+    // Move the piece back
+    board_.movePiece(move.to(), move.from());
+
+    // Restore the captured piece
+    if (capturedPiece)
+    {
+        Position capturedPosition = move.isEnPassant() ? Position(move.from().row, move.to().column) : move.to();
+        board_.putPiece(capturedPiece, capturedPosition);
+    }
+}
+
+void GameState::unmakeCastleMove(Move const & move)
+{
+    Move kingsMove = move.isKingSideCastle() ? Move::kingSideCastleKing(whoseTurn_) : Move::queenSideCastleKing(whoseTurn_);
+    board_.movePiece(kingsMove.to(), kingsMove.from());
+
+    Move rooksMove = move.isKingSideCastle() ? Move::kingSideCastleRook(whoseTurn_) : Move::queenSideCastleRook(whoseTurn_);
+    board_.movePiece(rooksMove.to(), rooksMove.from());
+}
+
+Piece const * GameState::promote(Position const & position, PieceTypeId type)
 {
     Piece const * pPiece = board_.pieceAt(position);
 
@@ -293,9 +735,9 @@ Piece const * GameState::promote(Position const & position)
     zhash_.remove(pPiece, position);
     board_.removePiece(position);
 
-    // Replace with a queen
+    // Replace with the new piece
 
-    Piece const * addedPiece = Piece::get(PieceTypeId::QUEEN, whoseTurn_); // @todo Not always promoted to a queen
+    Piece const * addedPiece = Piece::get(type, whoseTurn_);
 
     zhash_.add(addedPiece, position);
     board_.putPiece(addedPiece, position);
@@ -375,9 +817,10 @@ bool operator ==(GameState const & x, GameState const & y)
     if (x.zhash_.value() != y.zhash_.value())
         return false;
 
-    //! @todo	Actually this is not correct because en passant availability and the fifty-move status are part of the state, too
+    //! @todo	Actually this is not correct because the fifty-move status is part of the state, too
     return x.board_ == y.board_ &&
-           (x.castleStatus_ & CASTLE_AVAILABILITY_MASK) == (y.castleStatus_ & CASTLE_AVAILABILITY_MASK);
+           (x.castleStatus_ & CASTLE_AVAILABILITY_MASK) == (y.castleStatus_ & CASTLE_AVAILABILITY_MASK) &&
+           x.enPassant_ == y.enPassant_;
 }
 
 #if defined(ANALYSIS_GAME_STATE)
@@ -20,6 +20,41 @@ public:
 
     using CastleStatus = uint32_t;
 
+    // Number of half-moves without a capture or pawn move after which the fifty-move rule applies
+    static int constexpr FIFTY_MOVE_RULE_LIMIT = 100;
+
+    //! The attacks in a position. They are computed at most once per position, when first needed, and shared by
+    //! move generation, check detection and evaluation. The checks and pins are computed separately from the attacks
+    //! of each side, since move generation only needs the former.
+    struct AttackInfo
+    {
+        BitBoard bySide_[NUMBER_OF_COLORS];                         //!< Squares attacked by each side
+        BitBoard byType_[NUMBER_OF_COLORS][NUMBER_OF_PIECE_TYPES];  //!< Squares attacked by each type of piece
+        BitBoard checkers_;                     //!< Pieces giving check to the player whose turn it is
+        BitBoard pinned_;                       //!< Pieces of the player whose turn it is that are pinned to its king
+        BitBoard pinners_;                      //!< Pieces of the opponent pinning them
+        BitBoard kingDanger_;                   //!< Squares attacked by the opponent, seen through the king
+        int      mobility_[NUMBER_OF_COLORS];   //!< Sum of the moves of each queen, rook, bishop and knight
+        int      threats_[NUMBER_OF_COLORS];    //!< Sum of the pieces (of either color) attacked by each piece
+    };
+
+    //! The parts of the state that can't be recovered from a move when it is undone
+    struct UndoInfo
+    {
+        Piece const * capturedPiece_;   //!< The captured piece, if any
+        CastleStatus  castleStatus_;    //!< Castle status before the move
+        Square        enPassant_;       //!< En passant target before the move
+        int           fiftyMoveTimer_;  //!< Fifty move rule timer before the move
+        Move          move_;            //!< The move that resulted in the state before the move
+        bool          inCheck_;         //!< Check status before the move
+        ZHash         zhash_;           //!< Zobrist hash before the move
+        AttackInfo    attackInfo_;      //!< Attacks before the move (if they were computed)
+        unsigned      attackInfoValid_; //!< The parts of attackInfo_ that are valid
+#if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
+        float value_;                   //!< Value before the move
+#endif
+    };
+
     GameState() = default;
     GameState(Board const & board,
               Color         who,
@@ -55,12 +90,63 @@ public:
     //! Returns true if a piece of the specified color can occupy the position
     bool canBeOccupied(Position const & p, Color myColor) const;
 
+    //! Returns true if the position is attacked by any piece of the specified color
+    bool isAttacked(Position const & p, Color byColor) const;
+
+    //! Returns the locations of all pieces (of either color) attacking the position
+    BitBoard attackersTo(Position const & p) const;
+
+    //! Returns the locations of the pieces of the specified color attacking the position
+    BitBoard attackersTo(Position const & p, Color byColor) const;
+
+    //! Returns the locations of the pieces of the specified color attacking the position, with sliding attacks blocked
+    //! by the specified squares instead of the pieces on the board
+    BitBoard attackersTo(Position const & p, Color byColor, BitBoard const & occupied) const;
+
+    //! Returns all squares attacked by the pieces of the specified color, with sliding attacks blocked by the
+    //! specified squares instead of the pieces on the board
+    BitBoard attackedSquares(Color byColor, BitBoard const & occupied) const;
+
+    //! Returns true if the king of the specified color is attacked
+    bool kingIsAttacked(Color c) const;
+
+    //! Returns the attacks in this position. They are computed the first time they are needed after a change.
+    AttackInfo const & attackInfo() const
+    {
+        if (!(attackInfoValid_ & ATTACKS_VALID))
+            computeAttacks();
+        return checkInfo();
+    }
+
+    //! Returns the attacks in this position, but only checkers_, pinned_, pinners_ and kingDanger_ are valid
+    AttackInfo const & checkInfo() const
+    {
+        if (!(attackInfoValid_ & CHECKS_VALID))
+            computeChecks();
+        return attackInfo_;
+    }
+
     //! Returns the Z hash for this state
     ZHash zhash() const;
 
     //! Updates the game state with the specified move
     void makeMove(Move const & move);
 
+    //! Updates the game state with the specified move, saving what is needed to undo it
+    void makeMove(Move const & move, UndoInfo & undo);
+
+    //! Reverts the game state to what it was before the specified move was made with makeMove(move, undo)
+    void unmakeMove(Move const & move, UndoInfo const & undo);
+
+    //! Passes the turn to the other player without moving (a null move). Any en passant opportunity is lost.
+    void makeNullMove();
+
+    //! Makes a null move, saving what is needed to undo it
+    void makeNullMove(UndoInfo & undo);
+
+    //! Reverts the game state to what it was before a null move was made with makeNullMove(undo)
+    void unmakeNullMove(UndoInfo const & undo);
+
     //! Returns the FEN string for the state
     std::string fen() const;
 
@@ -68,7 +154,7 @@ public:
     Color whoseTurn_;           //!< Whose turn
     CastleStatus castleStatus_; //!< Which side has castled and which castles are still possible
     int fiftyMoveTimer_;        //!< Fifty move rule countdown
-    Position enPassant_;        //!< En passant target if any
+    Square enPassant_;          //!< En passant target if any
     Move move_;                 //!< The move that resulted in this state
     bool inCheck_;              //!< True if the king is in check
     int moveNumber_;            //!< Move number
@@ -90,20 +176,42 @@ private:
 
     friend bool operator ==(GameState const & x, GameState const & y);
 
-    // Updates the game state with a move (but not a castle)
-    void makeNormalMove(Move const & move);
+    // Parts of attackInfo_
+    static unsigned constexpr ATTACKS_VALID = 1 << 0; // bySide_, byType_, mobility_ and threats_
+    static unsigned constexpr CHECKS_VALID  = 1 << 1; // checkers_, pinned_, pinners_ and kingDanger_
+
+    // Computes the attacks of each side in this position
+    void computeAttacks() const;
+
+    // Computes the checks and pins of the player whose turn it is
+    void computeChecks() const;
+
+    // Updates the game state with any move, without saving anything to undo it. Returns the captured piece, if any.
+    Piece const * applyMove(Move const & move);
+
+    // Updates the game state with a move (but not a castle). Returns the captured piece, if any.
+    Piece const * makeNormalMove(Move const & move);
 
     // Updates the game state with a castle move
     void makeCastleMove(Move const & move);
 
+    // Reverts the board to what it was before a move (but not a castle)
+    void unmakeNormalMove(Move const & move, Piece const * capturedPiece);
+
+    // Reverts the board to what it was before a castle move
+    void unmakeCastleMove(Move const & move);
+
     // Updates the game state with a pawn promotion (after moving). Returns the new piece.
-    Piece const * promote(Position const & position);
+    Piece const * promote(Position const & position, PieceTypeId type);
 
     bool        whoseTurnFromFen(char const * start, char const * end);
     bool        castleStatusFromFen(char const * start, char const * end);
     bool        fiftyMoveTimerFromFen(char const * start, char const * end);
     bool        moveNumberFromFen(char const * start, char const * end);
     std::string castleStatusToFen() const;
+
+    mutable AttackInfo attackInfo_;             // Cached attacks
+    mutable unsigned   attackInfoValid_ = 0;    // The parts of attackInfo_ that are valid
 };
 
 bool operator ==(GameState const & x, GameState const & y);
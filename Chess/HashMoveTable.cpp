@@ -0,0 +1,54 @@
+#include "HashMoveTable.h"
+
+#include "Board.h"
+
+#include <cassert>
+
+HashMoveTable::HashMoveTable(size_t size)
+    : size_(1)
+{
+    // The number of entries is rounded down to a power of 2 so that the index is a mask of the fingerprint
+    assert(size > 0);
+    while (size_ * 2 <= size)
+        size_ *= 2;
+    table_.reset(new Entry[size_]);
+    clear();
+}
+
+bool HashMoveTable::probe(uint64_t fingerprint, Board const & board, Move & move) const
+{
+    Entry const & entry = table_[fingerprint & (size_ - 1)];
+    uint64_t      data  = entry.data.load(std::memory_order_relaxed);
+    uint64_t      check = entry.check.load(std::memory_order_relaxed);
+    if (data == 0 || (check ^ data) != fingerprint)
+        return false;
+
+    move = Move::unpack(Move::Packed(data), board);
+    return true;
+}
+
+void HashMoveTable::store(uint64_t fingerprint, Move const & move, int depth)
+{
+    assert(depth > 0);
+
+    // A deeper search of the same position is more likely to have found the best move. A different position is always
+    // replaced, since the newer position is more likely to be searched again.
+    Entry &  entry    = table_[fingerprint & (size_ - 1)];
+    uint64_t old      = entry.data.load(std::memory_order_relaxed);
+    uint64_t oldCheck = entry.check.load(std::memory_order_relaxed);
+    if ((oldCheck ^ old) == fingerprint && int(old >> DEPTH_SHIFT) > depth)
+        return;
+
+    uint64_t data = (uint64_t(depth) << DEPTH_SHIFT) | move.packed();
+    entry.check.store(fingerprint ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+void HashMoveTable::clear()
+{
+    for (size_t i = 0; i < size_; ++i)
+    {
+        table_[i].check.store(0, std::memory_order_relaxed);
+        table_[i].data.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,53 @@
+#if !defined(CHESS_HASHMOVETABLE_H)
+#define CHESS_HASHMOVETABLE_H
+
+#pragma once
+
+#include "Chess/Move.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class Board;
+
+// A table of the best move found in each position, keyed by the position's fingerprint and shared by several threads.
+//
+// The table is lock-free. An entry is two 64-bit words written and read separately, and the key is stored xor'ed with
+// the data, so an entry that is torn by simultaneous writes (or that belongs to a different position with the same
+// index) doesn't match the key. A move is only a hint for move ordering, and it is verified to be legal before it is
+// searched, so an entry that matches a different position with the same fingerprint is harmless.
+class HashMoveTable
+{
+public:
+    // Constructor. The number of entries is rounded down to a power of 2.
+    explicit HashMoveTable(size_t size);
+
+    // Returns the best move found in the position with the given fingerprint, or false if there is none. The board is
+    // the position's board, which supplies the types of the pieces that are not stored in the table.
+    bool probe(uint64_t fingerprint, Board const & board, Move & move) const;
+
+    // Stores the best move found in the position with the given fingerprint by a search of the given depth (at least
+    // 1). An entry for the same position is only replaced by a search that is at least as deep.
+    void store(uint64_t fingerprint, Move const & move, int depth);
+
+    // Forgets all the moves
+    void clear();
+
+    // Returns the number of entries
+    size_t size() const { return size_; }
+
+private:
+    struct Entry
+    {
+        std::atomic<uint64_t> check;    // Fingerprint ^ data
+        std::atomic<uint64_t> data;     // Depth << DEPTH_SHIFT | packed move, or 0 if the entry is empty
+    };
+
+    static int constexpr DEPTH_SHIFT = 16;
+
+    std::unique_ptr<Entry[]> table_;
+    size_t                   size_;
+};
+
+#endif // !defined(CHESS_HASHMOVETABLE_H)
@@ -2,185 +2,70 @@
 
 #include "GameState.h"
 #include "Move.h"
+#include "PieceMoves.h"
 
-void King::generatePossibleMoves(GameState const & state, Position const & from, MoveList & moves) const
+namespace
+{
+// Returns true if the 'span' squares next to the king in the given direction are empty and the two squares that the king
+// moves through are not attacked
+bool castlePathIsClear(GameState const & state, Color color, Position const & from, int direction, int span)
 {
     Board const & board = state.board_;
-    moves.reserve(moves.size() + MAX_POSSIBLE_MOVES);
-
-    // Normal moves
-
+    for (int i = 1; i <= span; ++i)
     {
-        Position to = from;
-
-        // Up
-
-        --to.row;
-        if ((to.row >= 0) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-
-        // Up-right
-
-        ++to.column;
-        if ((to.row >= 0) && (to.column < Board::SIZE) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-
-        // Right
-
-        ++to.row;
-        if ((to.column < Board::SIZE) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-
-        // Down-right
-
-        ++to.row;
-        if ((to.row < Board::SIZE) && (to.column < Board::SIZE) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-
-        // Down
-
-        --to.column;
-        if ((to.row < Board::SIZE) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-
-        // Down-left
-
-        --to.column;
-        if ((to.row < Board::SIZE) && (to.column >= 0) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-
-        // Left
+        if (board.pieceAt(from.row, from.column + i * direction))
+            return false;
+    }
 
-        --to.row;
-        if ((to.column >= 0) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
+    Color opponent = (color == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    return !state.isAttacked(Position(from.row, from.column + direction), opponent) &&
+           !state.isAttacked(Position(from.row, from.column + 2 * direction), opponent);
+}
+} // anonymous namespace
 
-        // Up-left
+void King::generatePossibleMoves(GameState const & state, Position const & from, MoveList & moves) const
+{
+    // Normal moves
 
-        --to.row;
-        if ((to.row >= 0) && (to.column >= 0) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-    }
+    PieceMoves::generate<PieceTypeId::KING>(state.board_, this, from, moves);
 
     // Castles
 
-    if (state.kingSideCastleIsAllowed(color_) && !state.inCheck_)
+    // All squares must be empty and un-threatened
+
+    if (state.kingSideCastleIsAllowed(color_) && !state.inCheck_ &&
+        castlePathIsClear(state, color_, from, (int)Direction::RIGHT, 2))
     {
-        // All squares must be empty and un-threatened
-        //! @todo Must check all squares that the kings moves through for being threatened
-        bool castleOk = true;
-        if ((state.board_.pieceAt(from.row, from.column + 1)) ||
-            (state.board_.pieceAt(from.row, from.column + 2)))
-        {
-            castleOk = false;
-        }
-        if (castleOk)
-            moves.emplace_back(Move::KINGSIDE_CASTLE, color_);
+        moves.emplace_back(Move::KINGSIDE_CASTLE, color_);
     }
 
-    if (state.queenSideCastleIsAllowed(color_) && !state.inCheck_)
+    if (state.queenSideCastleIsAllowed(color_) && !state.inCheck_ &&
+        castlePathIsClear(state, color_, from, (int)Direction::LEFT, 3))
     {
-        // All squares must be empty and un-threatened
-        //! @todo Must check all squares that the kings moves through for being threatened
-        bool castleOk = true;
-        if ((state.board_.pieceAt(from.row, from.column - 1)) ||
-            (state.board_.pieceAt(from.row, from.column - 2)) ||
-            (state.board_.pieceAt(from.row, from.column - 3)))
-        {
-            castleOk = false;
-        }
-        if (castleOk)
-            moves.emplace_back(Move::QUEENSIDE_CASTLE, color_, Position(), Position(), false);
+        moves.emplace_back(Move::QUEENSIDE_CASTLE, color_, Position(), Position(), false);
     }
 }
 
 int King::countPossibleMoves(GameState const & state, Position const & from) const
 {
-    int count = 0;
-
     // Normal moves
 
-    {
-        Position to = from;
-
-        // Up
-
-        --to.row;
-        if ((to.row >= 0) && state.canBeOccupied(to, color_))
-            ++count;
-
-        // Up-right
-
-        ++to.column;
-        if ((to.row >= 0) && (to.column < Board::SIZE) && state.canBeOccupied(to, color_))
-            ++count;
-
-        // Right
-
-        ++to.row;
-        if ((to.column < Board::SIZE) && state.canBeOccupied(to, color_))
-            ++count;
-
-        // Down-right
-
-        ++to.row;
-        if ((to.row < Board::SIZE) && (to.column < Board::SIZE) && state.canBeOccupied(to, color_))
-            ++count;
-
-        // Down
-
-        --to.column;
-        if ((to.row < Board::SIZE) && state.canBeOccupied(to, color_))
-            ++count;
-
-        // Down-left
-
-        --to.column;
-        if ((to.row < Board::SIZE) && (to.column >= 0) && state.canBeOccupied(to, color_))
-            ++count;
-
-        // Left
-
-        --to.row;
-        if ((to.column >= 0) && state.canBeOccupied(to, color_))
-            ++count;
-
-        // Up-left
-
-        --to.row;
-        if ((to.row >= 0) && (to.column >= 0) && state.canBeOccupied(to, color_))
-            ++count;
-    }
+    int count = PieceMoves::count<PieceTypeId::KING>(state.board_, color_, from);
 
     // Castles
 
-    if (state.kingSideCastleIsAllowed(color_) && !state.inCheck_)
+    // All squares must be empty and un-threatened
+
+    if (state.kingSideCastleIsAllowed(color_) && !state.inCheck_ &&
+        castlePathIsClear(state, color_, from, (int)Direction::RIGHT, 2))
     {
-        // All squares must be empty and un-threatened
-        //! @todo Must check all squares that the kings moves through for being threatened
-        bool castleOk = true;
-        if ((state.board_.pieceAt(from.row, from.column + 1)) ||
-            (state.board_.pieceAt(from.row, from.column + 2)))
-        {
-            castleOk = false;
-        }
-        if (castleOk)
-            ++count;
+        ++count;
     }
 
-    if (state.queenSideCastleIsAllowed(color_) && !state.inCheck_)
+    if (state.queenSideCastleIsAllowed(color_) && !state.inCheck_ &&
+        castlePathIsClear(state, color_, from, (int)Direction::LEFT, 3))
     {
-        // All squares must be empty and un-threatened
-        //! @todo Must check all squares that the kings moves through for being threatened
-        bool castleOk = true;
-        if ((state.board_.pieceAt(from.row, from.column - 1)) ||
-            (state.board_.pieceAt(from.row, from.column - 2)) ||
-            (state.board_.pieceAt(from.row, from.column - 3)))
-        {
-            castleOk = false;
-        }
-        if (castleOk)
-            ++count;
+        ++count;
     }
 
     return count;
@@ -188,59 +73,7 @@ int King::countPossibleMoves(GameState const & state, Position const & from) con
 
 int King::countThreats(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-    Position      to    = from;
-
-    // Up
-
-    --to.row;
-    if ((to.row >= 0) && board.pieceAt(to))
-        ++count;
-
-    // Up-right
-
-    ++to.column;
-    if ((to.row >= 0) && (to.column < Board::SIZE) && board.pieceAt(to))
-        ++count;
-
-    // Right
-
-    ++to.row;
-    if ((to.column < Board::SIZE) && board.pieceAt(to))
-        ++count;
-
-    // Down-right
-
-    ++to.row;
-    if ((to.row < Board::SIZE) && (to.column < Board::SIZE) && board.pieceAt(to))
-        ++count;
-
-    // Down
-
-    --to.column;
-    if ((to.row < Board::SIZE) && state.canBeOccupied(to, color_))
-        ++count;
-
-    // Down-left
-
-    --to.column;
-    if ((to.row < Board::SIZE) && (to.column >= 0) && board.pieceAt(to))
-        ++count;
-
-    // Left
-
-    --to.row;
-    if ((to.column >= 0) && board.pieceAt(to))
-        ++count;
-
-    // Up-left
-
-    --to.row;
-    if ((to.row >= 0) && (to.column >= 0) && board.pieceAt(to))
-        ++count;
-
-    return count;
+    return PieceMoves::countThreats<PieceTypeId::KING>(state.board_, from);
 }
 
 bool King::isValidMove(GameState const & state, Move const & move) const
@@ -248,40 +81,21 @@ bool King::isValidMove(GameState const & state, Move const & move) const
     Position const & from = move.from();
     Position const & to   = move.to();
 
-    // Check castles
+    // Check castles. Castle moves don't specify the king's location, so it is looked up. All squares between the king and
+    // the rook must be empty and the squares that the king moves through must be un-threatened.
 
     if (move.isKingSideCastle())
     {
         if (!state.kingSideCastleIsAllowed(color_) || state.inCheck_)
             return false;
-
-        // All squares must be empty and un-threatened
-        //! @todo Must check all squares that the kings moves through for being threatened
-        bool castleValid = true;
-        if ((state.board_.pieceAt(from.row, from.column + 1)) ||
-            (state.board_.pieceAt(from.row, from.column + 2)))
-        {
-            castleValid = false;
-        }
-        return castleValid;
+        return castlePathIsClear(state, color_, state.board_.kingPosition(color_), (int)Direction::RIGHT, 2);
     }
 
     if (move.isQueenSideCastle())
     {
-        //! @todo Must check all squares that the kings moves through
         if (!state.queenSideCastleIsAllowed(color_) || state.inCheck_)
             return false;
-
-        // All squares must be empty and un-threatened
-        //! @todo Must check all squares that the kings moves through for being threatened
-        bool castleValid = true;
-        if ((state.board_.pieceAt(from.row, from.column - 1)) ||
-            (state.board_.pieceAt(from.row, from.column - 2)) ||
-            (state.board_.pieceAt(from.row, from.column - 3)))
-        {
-            castleValid = false;
-        }
-        return castleValid;
+        return castlePathIsClear(state, color_, state.board_.kingPosition(color_), (int)Direction::LEFT, 3);
     }
 
     // Check if the destination square can be occupied
@@ -2,61 +2,21 @@
 
 #include "GameState.h"
 #include "Move.h"
-
-static Position const OFFSETS[] =
-{
-    { 2 * (int)Direction::UP,   1 * (int)Direction::LEFT  },
-    { 2 * (int)Direction::UP,   1 * (int)Direction::RIGHT },
-    { 1 * (int)Direction::UP,   2 * (int)Direction::RIGHT },
-    { 1 * (int)Direction::DOWN, 2 * (int)Direction::RIGHT },
-    { 2 * (int)Direction::DOWN, 1 * (int)Direction::LEFT  },
-    { 2 * (int)Direction::DOWN, 1 * (int)Direction::RIGHT },
-    { 1 * (int)Direction::UP,   2 * (int)Direction::LEFT  },
-    { 1 * (int)Direction::DOWN, 2 * (int)Direction::LEFT  }
-};
+#include "PieceMoves.h"
 
 void Knight::generatePossibleMoves(GameState const & state, Position const & from, MoveList & moves) const
 {
-    Board const & board = state.board_;
-
-    moves.reserve(moves.size() + MAX_POSSIBLE_MOVES);
-
-    for (auto const & o : OFFSETS)
-    {
-        Position to(from.row + o.row, from.column + o.column);
-        if (board.isValidPosition(to) && state.canBeOccupied(to, color_))
-            moves.emplace_back(this, from, to, (board.pieceAt(to) != nullptr));
-    }
+    PieceMoves::generate<PieceTypeId::KNIGHT>(state.board_, this, from, moves);
 }
 
 int Knight::countPossibleMoves(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-
-    for (auto const & o : OFFSETS)
-    {
-        Position to(from.row + o.row, from.column + o.column);
-        if (board.isValidPosition(to) && state.canBeOccupied(to, color_))
-            ++count;
-    }
-
-    return count;
+    return PieceMoves::count<PieceTypeId::KNIGHT>(state.board_, color_, from);
 }
 
 int Knight::countThreats(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-
-    for (auto const & o : OFFSETS)
-    {
-        Position to(from.row + o.row, from.column + o.column);
-        if (board.isValidPosition(to) && board.pieceAt(to))
-            ++count;
-    }
-
-    return count;
+    return PieceMoves::countThreats<PieceTypeId::KNIGHT>(state.board_, from);
 }
 
 bool Knight::isValidMove(GameState const & state, Move const & move) const
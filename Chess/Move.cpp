@@ -1,5 +1,6 @@
 #include "Move.h"
 
+#include "Board.h"
 #include "Move.h"
 #include "Piece.h"
 #include "Types.h"
@@ -7,39 +8,167 @@
 #include <cassert>
 #include <cstdlib>
 
+namespace
+{
+// The pieces a pawn can be promoted to, in the order of their promotion codes
+PieceTypeId constexpr PROMOTION_TYPES[] = { PieceTypeId::KNIGHT, PieceTypeId::BISHOP, PieceTypeId::ROOK, PieceTypeId::QUEEN };
+
+unsigned promotionIndex(PieceTypeId type)
+{
+    switch (type)
+    {
+        case PieceTypeId::KNIGHT: return 0;
+        case PieceTypeId::BISHOP: return 1;
+        case PieceTypeId::ROOK:   return 2;
+        case PieceTypeId::QUEEN:  return 3;
+        default:                  assert(false); return 3;
+    }
+}
+} // anonymous namespace
+
 Move::Move(Piece const * piece, Position const & from, Position const & to, bool capture /*= false*/)
-    : piece_(piece)
-    , from_(from)
-    , to_(to)
-    , capture_(capture)
-    , special_(NORMAL)
 {
+    assert(piece);
+    encode(from, to, capture ? CAPTURE : QUIET, piece->type(), piece->color(), PieceTypeId::INVALID);
+}
+
+Move::Move(Piece const * piece, Position const & from, Position const & to, Piece const * captured)
+{
+    assert(piece);
+    encode(from,
+           to,
+           captured ? CAPTURE : QUIET,
+           piece->type(),
+           piece->color(),
+           captured ? captured->type() : PieceTypeId::INVALID);
+}
+
+Move::Move(Piece const * piece, Square from, Square to, Piece const * captured)
+{
+    assert(piece);
+    encode(from,
+           to,
+           captured ? CAPTURE : QUIET,
+           piece->type(),
+           piece->color(),
+           captured ? captured->type() : PieceTypeId::INVALID);
 }
 
 Move::Move(Special          special,
            Color            color /*= Color::INVALID*/,
            Position const & from /*= Position()*/,
            Position const & to /*= Position()*/,
-           bool             capture /*= false*/)
-    : from_(from)
-    , to_(to)
-    , capture_(capture)
-    , special_(special)
-
+           bool             capture /*= false*/,
+           PieceTypeId      promotedTo /*= PieceTypeId::QUEEN*/,
+           PieceTypeId      captured /*= PieceTypeId::INVALID*/)
 {
     switch (special)
     {
-        case NORMAL:             piece_ = nullptr;                               break;
-        case RESIGN:             piece_ = Piece::get(PieceTypeId::KING, color);  break;
-        case UNDO:               piece_ = nullptr;                               break;
-        case RESET:              piece_ = nullptr;                               break;
-        case KINGSIDE_CASTLE:    piece_ = Piece::get(PieceTypeId::KING, color);  break;
-        case QUEENSIDE_CASTLE:   piece_ = Piece::get(PieceTypeId::KING, color);  break;
-        case PROMOTION:          piece_ = Piece::get(PieceTypeId::PAWN, color);  break;
-        case ENPASSANT:          piece_ = Piece::get(PieceTypeId::PAWN, color);  break;
+        case NORMAL:
+            encode(from, to, capture ? CAPTURE : QUIET, PieceTypeId::INVALID, color, PieceTypeId::INVALID);
+            break;
+        case RESIGN:
+            encode(Square(), Square(), RESIGN_CODE, PieceTypeId::KING, color, PieceTypeId::INVALID);
+            break;
+        case UNDO:
+            encode(Square(), Square(), UNDO_CODE, PieceTypeId::INVALID, color, PieceTypeId::INVALID);
+            break;
+        case RESET:
+            encode(Square(), Square(), RESET_CODE, PieceTypeId::INVALID, color, PieceTypeId::INVALID);
+            break;
+        case KINGSIDE_CASTLE:
+        {
+            // The king's move is recorded so that the compact form identifies the castle completely
+            assert(color != Color::INVALID);
+            Move king = kingSideCastleKing(color);
+            encode(king.from(), king.to(), KINGSIDE_CASTLE_CODE, PieceTypeId::KING, color, PieceTypeId::INVALID);
+            break;
+        }
+        case QUEENSIDE_CASTLE:
+        {
+            assert(color != Color::INVALID);
+            Move king = queenSideCastleKing(color);
+            encode(king.from(), king.to(), QUEENSIDE_CASTLE_CODE, PieceTypeId::KING, color, PieceTypeId::INVALID);
+            break;
+        }
+        case PROMOTION:
+            encode(from,
+                   to,
+                   (capture ? PROMOTION_CAPTURE_CODE : PROMOTION_CODE) | promotionIndex(promotedTo),
+                   PieceTypeId::PAWN,
+                   color,
+                   capture ? captured : PieceTypeId::INVALID);
+            break;
+        case ENPASSANT:
+            encode(from, to, ENPASSANT_CODE, PieceTypeId::PAWN, color, PieceTypeId::PAWN);
+            break;
     }
 }
 
+Piece const * Move::piece() const
+{
+    PieceTypeId type = movedType();
+    return (type != PieceTypeId::INVALID) ? Piece::get(type, color()) : nullptr;
+}
+
+Color Move::color() const
+{
+    // The color is only meaningful if there is a piece
+    if (movedType() == PieceTypeId::INVALID)
+        return Color::INVALID;
+    return ((value_ >> COLOR_SHIFT) & 1) ? Color::BLACK : Color::WHITE;
+}
+
+PieceTypeId Move::promotedTo() const
+{
+    return isPromotion() ? PROMOTION_TYPES[code() & 3] : PieceTypeId::INVALID;
+}
+
+Move::Special Move::special() const
+{
+    switch (code())
+    {
+        case QUIET:                 return NORMAL;
+        case CAPTURE:               return NORMAL;
+        case KINGSIDE_CASTLE_CODE:  return KINGSIDE_CASTLE;
+        case QUEENSIDE_CASTLE_CODE: return QUEENSIDE_CASTLE;
+        case ENPASSANT_CODE:        return ENPASSANT;
+        case RESIGN_CODE:           return RESIGN;
+        case UNDO_CODE:             return UNDO;
+        case RESET_CODE:            return RESET;
+        default:                    return PROMOTION;
+    }
+}
+
+Move Move::unpack(Packed packed, Board const & board)
+{
+    Move move;
+    move.value_ = packed;
+
+    // Fill in the piece types from the board
+    Piece const * moved    = move.hasSquares() ? board.pieceAt(move.from()) : nullptr;
+    Piece const * captured = (move.isCapture() && !move.isEnPassant()) ? board.pieceAt(move.to()) : nullptr;
+    PieceTypeId   capturedType = move.isEnPassant() ? PieceTypeId::PAWN : (captured ? captured->type() : PieceTypeId::INVALID);
+
+    move.value_ |= bitsFromType(moved ? moved->type() : PieceTypeId::INVALID) << MOVED_TYPE_SHIFT;
+    move.value_ |= ((moved && moved->color() == Color::BLACK) ? 1u : 0u) << COLOR_SHIFT;
+    move.value_ |= bitsFromType(capturedType) << CAPTURED_TYPE_SHIFT;
+    return move;
+}
+
+void Move::encode(Square from, Square to, unsigned code, PieceTypeId moved, Color color, PieceTypeId captured)
+{
+    uint32_t fromIndex = from.isValid() ? uint32_t(from.index()) : 0;
+    uint32_t toIndex   = to.isValid() ? uint32_t(to.index()) : 0;
+
+    value_ = (fromIndex << FROM_SHIFT) |
+             (toIndex << TO_SHIFT) |
+             (uint32_t(code) << CODE_SHIFT) |
+             (bitsFromType(moved) << MOVED_TYPE_SHIFT) |
+             ((color == Color::BLACK) ? (1u << COLOR_SHIFT) : 0u) |
+             (bitsFromType(captured) << CAPTURED_TYPE_SHIFT);
+}
+
 bool Move::isMoved(int dr, int dc)
 {
     return dr != 0 || dc != 0;
@@ -143,14 +272,14 @@ std::string Move::standardNotation() const
     }
     else if (isResignation())
     {
-        result = (piece_->color() == Color::WHITE) ? "1-0" : "0-1";
+        result = (color() == Color::WHITE) ? "1-0" : "0-1";
     }
     else
     {
-        PieceTypeId id = piece_->type();
+        PieceTypeId id = movedType();
         if (id != PieceTypeId::PAWN)
-            result = Piece::symbol(piece_->type());
-        if (capture_)
+            result = Piece::symbol(movedType());
+        if (isCapture())
         {
             if (id == PieceTypeId::PAWN)
                 result += from().notation()[0];
@@ -158,7 +287,7 @@ std::string Move::standardNotation() const
         }
         result += to().notation();
         if (isPromotion())
-            result += "Q";
+            result += Piece::symbol(promotedTo());
     }
     return result;
 }
@@ -182,17 +311,17 @@ std::string Move::longNotation() const
     }
     else if (isResignation())
     {
-        result = (piece_->color() == Color::WHITE) ? "1-0" : "0-1";
+        result = (color() == Color::WHITE) ? "1-0" : "0-1";
     }
     else
     {
-        if (piece_->type() != PieceTypeId::PAWN)
-            result = Piece::symbol(piece_->type());
+        if (movedType() != PieceTypeId::PAWN)
+            result = Piece::symbol(movedType());
         result += from().notation();
-        result += capture_ ? 'x' : '-';
+        result += isCapture() ? 'x' : '-';
         result += to().notation();
         if (isPromotion())
-            result += "Q";
+            result += Piece::symbol(promotedTo());
     }
     return result;
 }
@@ -216,18 +345,21 @@ std::string Move::pgnNotation() const
     }
     else if (isResignation())
     {
-        result = (piece_->color() == Color::WHITE) ? "1-0" : "0-1";
+        result = (color() == Color::WHITE) ? "1-0" : "0-1";
     }
     else
     {
-        PieceTypeId id = piece_->type();
+        PieceTypeId id = movedType();
         if (id != PieceTypeId::PAWN)
             result = Piece::symbol(id);
         result += from().notation();
-        result += capture_ ? 'x' : '-';
+        result += isCapture() ? 'x' : '-';
         result += to().notation();
         if (isPromotion())
-            result += "=Q";
+        {
+            result += '=';
+            result += Piece::symbol(promotedTo());
+        }
     }
     return result;
 }
@@ -251,14 +383,14 @@ std::string Move::figurineNotation() const
     }
     else if (isResignation())
     {
-        result = (piece_->color() == Color::WHITE) ? "1-0" : "0-1";
+        result = (color() == Color::WHITE) ? "1-0" : "0-1";
     }
     else
     {
-        PieceTypeId id = piece_->type();
+        PieceTypeId id = movedType();
         if (id != PieceTypeId::PAWN)
-            result = piece_->figurine();
-        if (capture_)
+            result = Piece::figurine(movedType(), color());
+        if (isCapture())
         {
             if (id == PieceTypeId::PAWN)
                 result += from().notation()[0];
@@ -266,7 +398,7 @@ std::string Move::figurineNotation() const
         }
         result += to().notation();
         if (isPromotion())
-            result += Piece::figurine(PieceTypeId::QUEEN, piece_->color());
+            result += Piece::figurine(promotedTo(), color());
     }
     return result;
 }
@@ -276,11 +408,11 @@ std::string Move::iccfNotation() const
     std::string result;
     if (isKingSideCastle())
     {
-        result = (piece_->color() == Color::WHITE) ? "5171" : "5878";
+        result = (color() == Color::WHITE) ? "5171" : "5878";
     }
     else if (isQueenSideCastle())
     {
-        result = (piece_->color() == Color::WHITE) ? "5131" : "5838";
+        result = (color() == Color::WHITE) ? "5131" : "5838";
     }
     else if (isResignation())
     {
@@ -293,7 +425,7 @@ std::string Move::iccfNotation() const
         result += to().column + '1';
         result += '8' - to().row;
         if (isPromotion())
-            result += '1';
+            result += char('1' + (promotionIndex(promotedTo()) ^ 3)); // 1 = queen ... 4 = knight
     }
     return result;
 }
@@ -317,18 +449,18 @@ std::string Move::uciNotation() const
     }
     else if (isResignation())
     {
-        result = (piece_->color() == Color::WHITE) ? "1-0" : "0-1";
+        result = (color() == Color::WHITE) ? "1-0" : "0-1";
     }
     else
     {
-        if (piece_->type() != PieceTypeId::PAWN)
-            result = Piece::symbol(piece_->type());
+        if (movedType() != PieceTypeId::PAWN)
+            result = Piece::symbol(movedType());
         result += from().notation();
-        if (capture_)
+        if (isCapture())
             result += 'x';
         result += to().notation();
         if (isPromotion())
-            result += "Q";
+            result += Piece::symbol(promotedTo());
     }
     return result;
 }
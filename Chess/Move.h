@@ -4,9 +4,13 @@
 #pragma once
 
 #include "Chess/Position.h"
+#include "Chess/Square.h"
 #include "Chess/Types.h"
+#include <cstdint>
+#include <string>
 #include <vector>
 
+class Board;
 class Piece;
 
 class Move
@@ -24,52 +28,88 @@ public:
         UNDO,
         RESET
     };
+
+    // The compact form of a move: from (6 bits), to (6 bits) and kind of move (4 bits)
+    using Packed = uint16_t;
+
     Move() = default;
     Move(Piece const * piece, Position const & from, Position const & to, bool capture = false);
+    Move(Piece const * piece, Position const & from, Position const & to, Piece const * captured);
+    Move(Piece const * piece, Square from, Square to, Piece const * captured);
     Move(Special          special,
-         Color            color   = Color::INVALID,
-         Position const & from    = Position(),
-         Position const & to      = Position(),
-         bool             capture = false);
+         Color            color      = Color::INVALID,
+         Position const & from       = Position(),
+         Position const & to         = Position(),
+         bool             capture    = false,
+         PieceTypeId      promotedTo = PieceTypeId::QUEEN,
+         PieceTypeId      captured   = PieceTypeId::INVALID);
 
     // Returns the piece being moved
-    Piece const * piece() const { return piece_; }
+    Piece const * piece() const;
+
+    // Returns the type of the piece being moved (or INVALID)
+    PieceTypeId movedType() const { return typeFromBits((value_ >> MOVED_TYPE_SHIFT) & TYPE_MASK); }
+
+    // Returns the color of the player making the move (or INVALID)
+    Color color() const;
+
+    // Returns the type of the captured piece (or INVALID if there is no capture or the type is unknown)
+    PieceTypeId capturedType() const { return typeFromBits((value_ >> CAPTURED_TYPE_SHIFT) & TYPE_MASK); }
+
+    // Returns the type of piece that a pawn is promoted to (or INVALID)
+    PieceTypeId promotedTo() const;
 
     // Returns the from position
-    Position from() const { return from_; }
+    Position from() const { return hasSquares() ? Position(fromIndex() / 8, fromIndex() % 8) : Position(); }
 
     // Returns the to position
-    Position to() const { return to_; }
+    Position to() const { return hasSquares() ? Position(toIndex() / 8, toIndex() % 8) : Position(); }
+
+    // Returns the from square
+    Square fromSquare() const { return hasSquares() ? Square(int(fromIndex())) : Square(); }
+
+    // Returns the to square
+    Square toSquare() const { return hasSquares() ? Square(int(toIndex())) : Square(); }
 
     // Returns the kind of special move (or NORMAL)
-    Special special() const { return special_; }
+    Special special() const;
 
     // Returns true if this is a special move
-    bool isSpecial() const { return special_ != NORMAL;  }
+    bool isSpecial() const { return code() > CAPTURE; }
 
     // Returns true if this move is a resignation
-    bool isResignation() const { return special_ == RESIGN;  }
+    bool isResignation() const { return code() == RESIGN_CODE;  }
 
     // Returns true if this is an undo
-    bool isUndo() const { return special_ == UNDO;  }
+    bool isUndo() const { return code() == UNDO_CODE;  }
 
     // Returns true if this is the starting position
-    bool isStartingPosition() const { return special_ == RESET;  }
+    bool isStartingPosition() const { return code() == RESET_CODE;  }
 
     // Returns true if this is a king-side castle
-    bool isKingSideCastle() const { return special_ == KINGSIDE_CASTLE;  }
+    bool isKingSideCastle() const { return code() == KINGSIDE_CASTLE_CODE;  }
 
     // Returns true if this is a queen-side castle
-    bool isQueenSideCastle() const { return special_ == QUEENSIDE_CASTLE;  }
+    bool isQueenSideCastle() const { return code() == QUEENSIDE_CASTLE_CODE;  }
 
     // Returns true if the pawn is promoted
-    bool isPromotion() const { return special_ == PROMOTION;  }
+    bool isPromotion() const { return (code() & PROMOTION_CODE) != 0;  }
 
     // Returns true if this is en passant
-    bool isEnPassant() const { return special_ == ENPASSANT;  }
+    bool isEnPassant() const { return code() == ENPASSANT_CODE;  }
 
     // Returns true if the move is marked as a capture
-    bool isCapture() const { return capture_; }
+    bool isCapture() const
+    {
+        unsigned c = code();
+        return c == CAPTURE || c == ENPASSANT_CODE || (c & PROMOTION_CAPTURE_CODE) == PROMOTION_CAPTURE_CODE;
+    }
+
+    // Returns the compact form of the move. The moved and captured piece types are not included.
+    Packed packed() const { return Packed(value_ & PACKED_MASK); }
+
+    // Returns the move corresponding to the compact form, getting the piece types from the board
+    static Move unpack(Packed packed, Board const & board);
 
     // Returns true if the difference is non-zero
     static bool isMoved(int dr, int dc);
@@ -101,14 +141,22 @@ public:
     // Special move -- Queen-side castle
     static Move queenSideCastle(Color color) { return Move(QUEENSIDE_CASTLE, color); }
 
-    // Special move -- Promotion
-    static Move promotion(Color color, Position const & from, Position const & to, bool capture = false)
+    // Special move -- Promotion. The type of the captured piece (if any) should be given so that the move is the same
+    // as the move unpacked from its compact form.
+    static Move promotion(Color              color,
+                          Position const &   from,
+                          Position const &   to,
+                          bool               capture    = false,
+                          PieceTypeId        promotedTo = PieceTypeId::QUEEN,
+                          PieceTypeId        captured   = PieceTypeId::INVALID)
     {
         return Move(PROMOTION,
                     color,
                     from,
                     to,
-                    capture);
+                    capture,
+                    promotedTo,
+                    captured);
     }
 
     // Special move -- En passant
@@ -128,6 +176,55 @@ public:
 
 private:
 
+    friend bool operator ==(Move const & a, Move const & b);
+
+    // Kinds of moves, stored in bits 12-15. A promotion code includes the piece promoted to in the low two bits.
+    enum Code : unsigned
+    {
+        QUIET = 0,
+        CAPTURE,
+        KINGSIDE_CASTLE_CODE,
+        QUEENSIDE_CASTLE_CODE,
+        ENPASSANT_CODE,
+        RESIGN_CODE,
+        UNDO_CODE,
+        RESET_CODE,
+        PROMOTION_CODE         = 8,
+        PROMOTION_CAPTURE_CODE = 12
+    };
+
+    // Layout of value_
+    //     bits  0-5  : from square (row * 8 + column)
+    //     bits  6-11 : to square
+    //     bits 12-15 : kind of move (Code)
+    //     bits 16-18 : type of the moved piece (NO_TYPE if none)
+    //     bit  19    : color of the moved piece
+    //     bits 20-22 : type of the captured piece (NO_TYPE if none or unknown)
+    static int constexpr      FROM_SHIFT          = 0;
+    static int constexpr      TO_SHIFT            = 6;
+    static int constexpr      CODE_SHIFT          = 12;
+    static int constexpr      MOVED_TYPE_SHIFT    = 16;
+    static int constexpr      COLOR_SHIFT         = 19;
+    static int constexpr      CAPTURED_TYPE_SHIFT = 20;
+    static uint32_t constexpr SQUARE_MASK         = 0x3f;
+    static uint32_t constexpr CODE_MASK           = 0xf;
+    static uint32_t constexpr TYPE_MASK           = 0x7;
+    static uint32_t constexpr NO_TYPE             = TYPE_MASK;
+    static uint32_t constexpr PACKED_MASK         = 0xffff;
+
+    unsigned code() const      { return (value_ >> CODE_SHIFT) & CODE_MASK; }
+    unsigned fromIndex() const { return (value_ >> FROM_SHIFT) & SQUARE_MASK; }
+    unsigned toIndex() const   { return (value_ >> TO_SHIFT) & SQUARE_MASK; }
+
+    // Returns true if the move has from and to squares
+    bool hasSquares() const { unsigned c = code(); return c != RESIGN_CODE && c != UNDO_CODE && c != RESET_CODE; }
+
+    // Sets the value from its components
+    void encode(Square from, Square to, unsigned code, PieceTypeId moved, Color color, PieceTypeId captured);
+
+    static PieceTypeId typeFromBits(uint32_t bits) { return (bits == NO_TYPE) ? PieceTypeId::INVALID : PieceTypeId(bits); }
+    static uint32_t    bitsFromType(PieceTypeId type) { return (type == PieceTypeId::INVALID) ? NO_TYPE : uint32_t(type); }
+
     std::string standardNotation() const;
     std::string longNotation() const;
     std::string pgnNotation() const;
@@ -135,11 +232,19 @@ private:
     std::string iccfNotation() const;
     std::string uciNotation() const;
 
-    Piece const * piece_;   // The piece that moved
-    Position from_;         // Beginning location
-    Position to_;           // Ending location
-    bool capture_;          // True if this is a capture
-    Special special_;       // Kind of move
+    uint32_t value_;    // The encoded move
 };
 
+static_assert(sizeof(Move) == 4, "Move is expected to be 32 bits");
+
+inline bool operator ==(Move const & a, Move const & b)
+{
+    return a.value_ == b.value_;
+}
+
+inline bool operator !=(Move const & a, Move const & b)
+{
+    return !(a == b);
+}
+
 #endif // !defined(CHESS_MOVE_H)
@@ -0,0 +1,269 @@
+#include "MoveGenerator.h"
+
+#include "Board.h"
+#include "GameState.h"
+#include "Move.h"
+#include "Piece.h"
+#include "PieceMoves.h"
+#include "Position.h"
+#include "Square.h"
+#include "Types.h"
+
+#include <BitBoard/BitBoard.h>
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+uint64_t constexpr ALL_SQUARES = ~uint64_t(0);
+
+// Pieces other than the king and pawns, which are handled separately
+PieceTypeId constexpr OTHER_PIECE_TYPES[] = { PieceTypeId::QUEEN, PieceTypeId::ROOK, PieceTypeId::BISHOP, PieceTypeId::KNIGHT };
+
+int index(int r, int c)
+{
+    return r * Board::SIZE + c;
+}
+
+uint64_t mask(int r, int c)
+{
+    return uint64_t(1) << index(r, c);
+}
+
+// Returns true if exactly one square is set
+bool isSingle(uint64_t b)
+{
+    return b != 0 && (b & (b - 1)) == 0;
+}
+
+// Returns the squares attacked by a piece (other than a pawn) of the given type on the given square
+uint64_t attacks(PieceTypeId type, Square s, BitBoard const & occupied)
+{
+    if (type == PieceTypeId::KNIGHT || type == PieceTypeId::KING)
+        return BitBoard::threatened((int)type, s.index());
+    return BitBoard::slidingAttacks((int)type, s.index(), occupied);
+}
+
+// The state of a node that is common to the generation of all moves
+struct Context
+{
+    Context(GameState const & state, MoveGenerator::Kind kind, uint64_t froms);
+
+    GameState const & state;
+    Board const &     board;
+    Color             us;
+    Color             them;
+    BitBoard          occupied;
+    uint64_t          ours;
+    uint64_t          theirs;
+    Position          king;
+    uint64_t          checkers;                     // The pieces giving check
+    uint64_t          checkMask;                    // Moves must end on these squares to resolve a check
+    uint64_t          pinned;                       // Our pieces that are pinned to the king
+    uint64_t          pinRays[Board::SIZE * Board::SIZE]; // The squares a pinned piece can move to (valid if pinned)
+    uint64_t          kingDanger;                   // The squares the king can't move to
+    bool              captures;                     // True if captures and promotions are generated
+    bool              quiets;                       // True if other moves are generated
+    uint64_t          targets;                      // Non-pawn moves are limited to these squares
+    uint64_t          froms;                        // Only moves by pieces on these squares are generated
+};
+
+Context::Context(GameState const & s, MoveGenerator::Kind kind, uint64_t f)
+    : state(s)
+    , board(s.board_)
+    , us(s.whoseTurn_)
+    , them((s.whoseTurn_ == Color::WHITE) ? Color::BLACK : Color::WHITE)
+    , occupied(s.board_.occupied())
+    , ours(s.board_.occupied(us))
+    , theirs(s.board_.occupied(them))
+    , king(s.board_.kingPosition(us))
+    , checkers(s.checkInfo().checkers_)
+    , checkMask(ALL_SQUARES)
+    , pinned(s.checkInfo().pinned_)
+    , kingDanger(s.checkInfo().kingDanger_)
+    , captures(kind != MoveGenerator::QUIETS)
+    , quiets(kind != MoveGenerator::CAPTURES)
+    , targets((captures ? theirs : 0) | (quiets ? ~(ours | theirs) : 0))
+    , froms(f)
+{
+    assert(Board::isValidPosition(king));
+
+    // If there is only one checking piece, the check can be resolved by capturing it or by blocking it
+    if (isSingle(checkers))
+    {
+        int r, c;
+        BitBoard(checkers).first(r, c);
+        checkMask = checkers | uint64_t(BitBoard::between(king.row, king.column, r, c));
+    }
+
+    // A pinned piece can only move along the line between the king and the piece pinning it
+    int kingIndex = index(king.row, king.column);
+    for (int i : s.checkInfo().pinners_)
+    {
+        uint64_t between = BitBoard::between(kingIndex, i);
+        int      p       = 0;
+        bool     found   = BitBoard(between & pinned).first(p);
+        assert(found);
+        (void)found;
+        pinRays[p] = between | (uint64_t(1) << i);
+    }
+}
+
+// Adds a move for each destination
+void addMoves(Context const & context, Piece const * piece, Square from, BitBoard targets, MoveList & moves)
+{
+    int i;
+    while (targets.popFirst(i))
+    {
+        Square to(i);
+        moves.emplace_back(piece, from, to, context.board.pieceAt(to));
+    }
+}
+
+void generateKingMoves(Context const & context, MoveList & moves)
+{
+    Position const & from = context.king;
+    Piece const *    king = Piece::get(PieceTypeId::KING, context.us);
+
+    if ((context.froms & mask(from.row, from.column)) == 0)
+        return;
+
+    // The king can't move to an attacked square, including a square behind it on the line of attack of a slider
+    uint64_t attacked = context.kingDanger;
+    BitBoard targets(uint64_t(BitBoard::threatened(BitBoard::KING, from.row, from.column)) & context.targets & ~attacked);
+    int      r, c;
+    while (targets.popFirst(r, c))
+    {
+        Position to(r, c);
+        moves.emplace_back(king, from, to, context.board.pieceAt(to));
+    }
+
+    // Castles are not allowed when in check, through occupied squares or through attacked squares
+    if (context.checkers || !context.quiets)
+        return;
+
+    Piece const * rook = Piece::get(PieceTypeId::ROOK, context.us);
+    if (context.state.kingSideCastleIsAllowed(context.us) &&
+        context.board.pieceAt(from.row, Board::SIZE - 1) == rook &&
+        !context.board.isOccupied(from.row, from.column + 1) &&
+        !context.board.isOccupied(from.row, from.column + 2) &&
+        !(attacked & mask(from.row, from.column + 1)) &&
+        !(attacked & mask(from.row, from.column + 2)))
+    {
+        moves.emplace_back(Move::KINGSIDE_CASTLE, context.us);
+    }
+
+    if (context.state.queenSideCastleIsAllowed(context.us) &&
+        context.board.pieceAt(from.row, 0) == rook &&
+        !context.board.isOccupied(from.row, from.column - 1) &&
+        !context.board.isOccupied(from.row, from.column - 2) &&
+        !context.board.isOccupied(from.row, from.column - 3) &&
+        !(attacked & mask(from.row, from.column - 1)) &&
+        !(attacked & mask(from.row, from.column - 2)))
+    {
+        moves.emplace_back(Move::QUEENSIDE_CASTLE, context.us);
+    }
+}
+
+void generatePieceMoves(Context const & context, MoveList & moves)
+{
+    for (auto type : OTHER_PIECE_TYPES)
+    {
+        Piece const * piece = Piece::get(type, context.us);
+        BitBoard      froms(uint64_t(context.board.pieces(type, context.us)) & context.froms);
+        int           i;
+        while (froms.popFirst(i))
+        {
+            Square   from(i);
+            uint64_t targets = attacks(type, from, context.occupied) & context.targets & context.checkMask;
+            if (context.pinned & (uint64_t(1) << i))
+                targets &= context.pinRays[i];
+            addMoves(context, piece, from, BitBoard(targets), moves);
+        }
+    }
+}
+
+// Returns true if capturing en passant would leave the king in check. This can't be determined from the pins because
+// two pieces leave the row.
+bool enPassantExposesKing(Context const & context, Position const & from, Position const & to)
+{
+    uint64_t captured = mask(from.row, to.column);
+    BitBoard occupied((uint64_t(context.occupied) & ~mask(from.row, from.column) & ~captured) | mask(to.row, to.column));
+    return (uint64_t(context.state.attackersTo(context.king, context.them, occupied)) & ~captured) != 0;
+}
+
+void generatePawnMoves(Context const & context, MoveList & moves)
+{
+    // The pawns that are not pinned are generated all at once. Pinned pawns are generated one at a time, since each
+    // one can only move along its own pin.
+    uint64_t pawns = uint64_t(context.board.pieces(PieceTypeId::PAWN, context.us)) & context.froms;
+    PieceMoves::generatePawnMoves(context.board,
+                                  context.us,
+                                  BitBoard(pawns & ~context.pinned),
+                                  context.checkMask,
+                                  context.captures,
+                                  context.quiets,
+                                  moves);
+
+    BitBoard pinned(pawns & context.pinned);
+    int      i;
+    while (pinned.popFirst(i))
+    {
+        PieceMoves::generatePawnMoves(context.board,
+                                      context.us,
+                                      BitBoard(uint64_t(1) << i),
+                                      context.checkMask & context.pinRays[i],
+                                      context.captures,
+                                      context.quiets,
+                                      moves);
+    }
+
+    // En passant is possible for the pawns that would be attacked by an opponent's pawn on the target square. The
+    // check and the pins are handled by testing whether the capture exposes the king.
+    Square target = context.state.enPassant_;
+    if (!context.captures || !target.isValid())
+        return;
+
+    BitBoard::PawnColor them = (BitBoard::PawnColor)context.them;
+    BitBoard            froms(pawns & uint64_t(BitBoard::pawnThreatened(them, target.index())));
+    while (froms.popFirst(i))
+    {
+        Position from = Square(i).position();
+        Position to   = target.position();
+        if (!enPassantExposesKing(context, from, to))
+            moves.emplace_back(Move::ENPASSANT, context.us, from, to, true);
+    }
+}
+} // anonymous namespace
+
+void MoveGenerator::generateLegalMoves(GameState const & state, MoveList & moves, Kind kind /*= ALL*/)
+{
+    Context context(state, kind, ALL_SQUARES);
+
+    generateKingMoves(context, moves);
+
+    // If the king is in double check, only the king can move
+    if (context.checkers && !isSingle(context.checkers))
+        return;
+
+    generatePieceMoves(context, moves);
+    generatePawnMoves(context, moves);
+}
+
+bool MoveGenerator::isLegal(GameState const & state, Move const & move)
+{
+    // Only the moves of the piece that moves are generated
+    Position from = move.from();
+    if (!Board::isValidPosition(from) || move.color() != state.whoseTurn_)
+        return false;
+
+    Context  context(state, ALL, mask(from.row, from.column));
+    MoveList moves;
+    generateKingMoves(context, moves);
+    if (!context.checkers || isSingle(context.checkers))
+    {
+        generatePieceMoves(context, moves);
+        generatePawnMoves(context, moves);
+    }
+    return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
@@ -0,0 +1,33 @@
+#if !defined(CHESS_MOVEGENERATOR_H)
+#define CHESS_MOVEGENERATOR_H
+
+#pragma once
+
+#include "Chess/MoveList.h"
+
+class GameState;
+
+// Generates strictly legal moves.
+//
+// Unlike Piece::generatePossibleMoves, which generates moves that might leave the king in check, this generator
+// computes the checking pieces and the pinned pieces once per node and only generates moves that are legal. When the
+// king is in check, only evasions are generated (king moves, captures of the checking piece, and blocks).
+class MoveGenerator
+{
+public:
+    // Subsets of the legal moves
+    enum Kind
+    {
+        ALL,
+        CAPTURES,   // Captures (including en passant) and promotions
+        QUIETS      // All other moves (including castles)
+    };
+
+    // Generates the legal moves of the specified kind for the player whose turn it is
+    static void generateLegalMoves(GameState const & state, MoveList & moves, Kind kind = ALL);
+
+    // Returns true if the move is legal for the player whose turn it is
+    static bool isLegal(GameState const & state, Move const & move);
+};
+
+#endif // !defined(CHESS_MOVEGENERATOR_H)
@@ -0,0 +1,76 @@
+#if !defined(CHESS_MOVELIST_H)
+#define CHESS_MOVELIST_H
+
+#pragma once
+
+#include "Chess/Move.h"
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+// A fixed-capacity list of moves that does not allocate. It is intended to live on the stack, one per node, and
+// provides the subset of the std::vector interface used by the move generators.
+class MoveList
+{
+public:
+    // The maximum number of legal moves in any position is 218. Pseudo-legal moves (which can leave the king in
+    // check) can exceed that slightly, so the capacity is rounded up.
+    static size_t constexpr CAPACITY = 256;
+
+    using value_type     = Move;
+    using iterator       = Move *;
+    using const_iterator = Move const *;
+
+    MoveList() = default;
+
+    // Adds a move to the end of the list
+    void push_back(Move const & move)
+    {
+        assert(size_ < CAPACITY);
+        moves_[size_++] = move;
+    }
+
+    // Constructs a move at the end of the list
+    template <typename... Args>
+    void emplace_back(Args &&... args)
+    {
+        assert(size_ < CAPACITY);
+        moves_[size_++] = Move(std::forward<Args>(args)...);
+    }
+
+    // Removes the last move
+    void pop_back()
+    {
+        assert(size_ > 0);
+        --size_;
+    }
+
+    // Removes all the moves
+    void clear() { size_ = 0; }
+
+    // Returns the number of moves in the list
+    size_t size() const { return size_; }
+
+    // Returns true if the list is empty
+    bool empty() const { return size_ == 0; }
+
+    // Returns the maximum number of moves in the list
+    static size_t capacity() { return CAPACITY; }
+
+    Move & operator [](size_t i)             { assert(i < size_); return moves_[i]; }
+    Move const & operator [](size_t i) const { assert(i < size_); return moves_[i]; }
+
+    Move & back()             { assert(size_ > 0); return moves_[size_ - 1]; }
+    Move const & back() const { assert(size_ > 0); return moves_[size_ - 1]; }
+
+    iterator       begin()       { return moves_; }
+    iterator       end()         { return moves_ + size_; }
+    const_iterator begin() const { return moves_; }
+    const_iterator end() const   { return moves_ + size_; }
+
+private:
+    Move   moves_[CAPACITY]; // Storage (not initialized)
+    size_t size_ = 0;        // Number of moves in the list
+};
+
+#endif // !defined(CHESS_MOVELIST_H)
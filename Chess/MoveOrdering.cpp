@@ -0,0 +1,129 @@
+#include "MoveOrdering.h"
+
+#include "GameState.h"
+#include "Square.h"
+#include "StagedMoveGenerator.h"
+#include "StaticEvaluator.h"
+
+#include <algorithm>
+
+namespace
+{
+// Returns true if the move neither captures nor promotes
+bool isQuiet(Move const & move)
+{
+    return !move.isCapture() && !move.isPromotion();
+}
+} // anonymous namespace
+
+MoveOrdering::MoveOrdering()
+{
+    clear();
+}
+
+int MoveOrdering::priority(MoveOrdering const * ordering, GameState const & state, Move const & move, int ply)
+{
+    // Captures and promotions are ordered by the material they win, with ties broken by MVV/LVA. Those that lose
+    // material come after the quiet moves.
+    if (!isQuiet(move))
+    {
+        int see      = StaticEvaluator::see(state, move);
+        int priority = see * SEE_SCALE + StagedMoveGenerator::mvvLva(state, move);
+        return (see >= 0) ? CAPTURE_PRIORITY + priority : priority - CAPTURE_PRIORITY;
+    }
+    if (!ordering)
+        return 0;
+
+    // The first killer is the most recent, so it comes first
+    Move const * killers = ordering->killers(ply);
+    for (int i = 0; i < StagedMoveGenerator::MAX_KILLERS; ++i)
+    {
+        if (move == killers[i])
+            return KILLER_PRIORITY + StagedMoveGenerator::MAX_KILLERS - i;
+    }
+
+    return ordering->quietPriority(state, move);
+}
+
+int MoveOrdering::quietPriority(GameState const & state, Move const & move) const
+{
+    int previous = countermoveIndex(state.move_);
+    if (previous >= 0 && move == countermoves_[previous])
+        return COUNTERMOVE_PRIORITY;
+
+    return history(move);
+}
+
+void MoveOrdering::recordCutoff(GameState const & state, Move const & move, int depth, int ply)
+{
+    // Captures are already ordered by the material they win
+    if (!isQuiet(move))
+        return;
+
+    int & score = history_[(int)move.color()][move.fromSquare().index()][move.toSquare().index()];
+    score = std::min(score + depth * depth, MAX_HISTORY - 1);
+
+    if (ply < MAX_PLY)
+    {
+        Move * killers = killers_[ply];
+        if (killers[0] != move)
+        {
+            std::copy_backward(killers,
+                               killers + StagedMoveGenerator::MAX_KILLERS - 1,
+                               killers + StagedMoveGenerator::MAX_KILLERS);
+            killers[0] = move;
+        }
+    }
+
+    int previous = countermoveIndex(state.move_);
+    if (previous >= 0)
+        countermoves_[previous] = move;
+}
+
+int MoveOrdering::history(Move const & move) const
+{
+    return history_[(int)move.color()][move.fromSquare().index()][move.toSquare().index()];
+}
+
+Move const * MoveOrdering::killers(int ply) const
+{
+    static Move const NONE[StagedMoveGenerator::MAX_KILLERS] = {};
+    return (ply < MAX_PLY) ? killers_[ply] : NONE;
+}
+
+int MoveOrdering::countermoveIndex(Move const & previous)
+{
+    // The previous move is not a move on the board if the state is the start of a game or follows a null move
+    Square from = previous.fromSquare();
+    Square to   = previous.toSquare();
+    if (!from.isValid() || !to.isValid() || from == to)
+        return -1;
+    return ((int)previous.color() * Square::COUNT + from.index()) * Square::COUNT + to.index();
+}
+
+void MoveOrdering::age()
+{
+    for (auto & from : history_)
+    {
+        for (auto & to : from)
+        {
+            for (auto & score : to)
+            {
+                score /= 2;
+            }
+        }
+    }
+}
+
+void MoveOrdering::clear()
+{
+    for (auto & ply : killers_)
+    {
+        std::fill(std::begin(ply), std::end(ply), Move());
+    }
+    for (auto & from : history_)
+    {
+        std::fill(&from[0][0], &from[0][0] + 64 * 64, 0);
+    }
+    std::fill(std::begin(countermoves_), std::end(countermoves_), Move());
+}
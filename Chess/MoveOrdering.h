@@ -0,0 +1,73 @@
+#if !defined(CHESS_MOVEORDERING_H)
+#define CHESS_MOVEORDERING_H
+
+#pragma once
+
+#include "Chess/Move.h"
+#include "Chess/StagedMoveGenerator.h"
+
+class GameState;
+
+// Tables of the moves that caused beta cutoffs, used to order the moves of a node so that a cutoff is likely to come
+// early.
+//
+// A move is prioritized as follows: captures and promotions that don't lose material (by static exchange evaluation,
+// with ties broken by most valuable victim, then least valuable attacker), the killer moves of the ply (quiet moves
+// that caused a cutoff in a sibling node), the countermove of the previous move (the quiet move that last refuted
+// it), the remaining quiet moves ordered by their history (how often and how deeply they have caused cutoffs), and
+// finally the captures and promotions that lose material.
+//
+// The tables are not synchronized, so each thread must have its own.
+class MoveOrdering
+{
+public:
+    // Killer moves are kept for this many plies
+    static int constexpr MAX_PLY = 64;
+
+    // Base priorities of each kind of move. Quiet moves are prioritized by their history, which is less than
+    // COUNTERMOVE_PRIORITY.
+    static int constexpr CAPTURE_PRIORITY     = 4 << 24;
+    static int constexpr KILLER_PRIORITY      = 3 << 24;
+    static int constexpr COUNTERMOVE_PRIORITY = 2 << 24;
+    static int constexpr MAX_HISTORY          = 1 << 24;
+
+    // Static exchange values are scaled by this so that MVV/LVA scores only break ties
+    static int constexpr SEE_SCALE = 1 << 10;
+
+    // Constructor
+    MoveOrdering();
+
+    // Returns the priority of a move in the given state. The ply is the ply of the state that the move results in.
+    // Higher priorities are searched first. If ordering is null, only captures and promotions are prioritized.
+    static int priority(MoveOrdering const * ordering, GameState const & state, Move const & move, int ply);
+
+    // Returns the priority of a quiet move that is not a killer move: COUNTERMOVE_PRIORITY if it is the countermove of
+    // the previous move, or otherwise its history
+    int quietPriority(GameState const & state, Move const & move) const;
+
+    // Records a quiet move that caused a cutoff in the given state, searched with the given depth left. The ply is the
+    // ply of the state that the move results in.
+    void recordCutoff(GameState const & state, Move const & move, int depth, int ply);
+
+    // Returns the history score of a move
+    int history(Move const & move) const;
+
+    // Returns the killer moves of a ply (StagedMoveGenerator::MAX_KILLERS of them, invalid if not set)
+    Move const * killers(int ply) const;
+
+    // Gives the history less weight, typically at the start of a new search
+    void age();
+
+    // Forgets everything
+    void clear();
+
+private:
+    // Returns the index of the previous move in countermoves_, or -1 if there is no previous move
+    static int countermoveIndex(Move const & previous);
+
+    Move killers_[MAX_PLY][StagedMoveGenerator::MAX_KILLERS];
+    int  history_[2][64][64];        // Indexed by color, from and to
+    Move countermoves_[2 * 64 * 64]; // Indexed by the color, from and to of the previous move
+};
+
+#endif // !defined(CHESS_MOVEORDERING_H)
@@ -2,99 +2,22 @@
 
 #include "GameState.h"
 #include "Move.h"
+#include "PieceMoves.h"
+#include "Square.h"
 
 void Pawn::generatePossibleMoves(GameState const & state, Position const & from, MoveList & moves) const
 {
-    Board const & board = state.board_;
-
-    int direction = (color_ == Color::BLACK) ? (int)Direction::DOWN : (int)Direction::UP;
-
-    moves.reserve(moves.size() + MAX_POSSIBLE_MOVES);
-
-    Position to;
-
-    // Diagonal to left (must capture)
-
-    to.row    = from.row + direction;
-    to.column = from.column + (int)Direction::LEFT;
-
-    if (board.isValidPosition(to))
-    {
-        Piece const * captured = board.pieceAt(to);
-
-        if (captured && (captured->color() != color_))
-        {
-            moves.emplace_back(this, from, to, true);
-        }
-        else
-        {
-            // Note: If a piece can be captured normally, then it is impossible for a pawn to have moved two
-            // spaces (and be open to capture by en passant).
-            // Check en passant -- if the piece next to the destination square is a pawn and the previous move was
-            // a two-space move to that square (assumed to be made by the pawn), then en passant is possible.
-
-            captured = board.pieceAt(from.row, to.column);
-
-            if (captured &&
-                (captured->type() == PieceTypeId::PAWN) &&
-                (state.move_.from() == Position(to.row + direction, to.column)) &&
-                (state.move_.to() == Position(from.row, to.column)))
-            {
-                moves.emplace_back(Move::ENPASSANT, color_, from, to, true);
-            }
-        }
-    }
-
-    // Diagonal to right (must capture)
-
-    to.row    = from.row + direction;
-    to.column = from.column + (int)Direction::RIGHT;
-
-    if (board.isValidPosition(to))
-    {
-        Piece const * captured = board.pieceAt(to);
+    Square   square(from);
+    BitBoard pawn(uint64_t(1) << square.index());
+    PieceMoves::generatePawnMoves(state.board_, color_, pawn, ~uint64_t(0), true, true, moves);
 
-        if (captured && (captured->color() != color_))
-        {
-            moves.emplace_back(this, from, to, (captured != NO_PIECE));
-        }
-        else
-        {
-            // Note: If a piece can be captured normally, then it is impossible for a pawn to have moved two
-            // spaces (and be open to capture by en passant).
-            // Check en passant -- if the piece next to the destination square is a pawn and the previous move was
-            // a two-space move to that square (assumed to be made by the pawn), then en passant is possible.
-
-            captured = board.pieceAt(from.row, to.column);
-
-            if (captured &&
-                (captured->type() == PieceTypeId::PAWN) &&
-                (state.move_.from() == Position(to.row + direction, to.column)) &&
-                (state.move_.to() == Position(from.row, to.column)))
-            {
-                moves.emplace_back(Move::ENPASSANT, color_, from, to, true);
-            }
-        }
-    }
-
-    // Ahead 1 row (must be empty) and ahead 2 rows (must be empty)
-
-    to.row    = from.row + direction;
-    to.column = from.column;
-
-    if (board.isValidPosition(to) && (board.pieceAt(to) == NO_PIECE))
+    // Check en passant -- if the previous move was a two-space pawn move past the destination square, then en passant
+    // is possible.
+    if (state.enPassant_.isValid() && (state.whoseTurn_ == color_))
     {
-        moves.emplace_back(this, from, to);
-
-        // Ahead 2 rows if in its original spot (must be empty)
-
-        if (((from.row == STARTING_ROW_BLACK) && (color_ == Color::BLACK)) ||
-            ((from.row == STARTING_ROW_WHITE) && (color_ == Color::WHITE)))
-        {
-            to.row += direction;
-            if (board.pieceAt(to) == NO_PIECE)
-                moves.emplace_back(this, from, to);
-        }
+        BitBoard::PawnColor pawnColor = (BitBoard::PawnColor)color_;
+        if (uint64_t(BitBoard::pawnThreatened(pawnColor, square.index())) & (uint64_t(1) << state.enPassant_.index()))
+            moves.emplace_back(Move::ENPASSANT, color_, from, state.enPassant_.position(), true);
     }
 }
 
@@ -118,21 +41,16 @@ int Pawn::countPossibleMoves(GameState const & state, Position const & from) con
 
         if (captured && (captured->color() != color_))
         {
-            ++count;
+            count += movesTo(to);
         }
         else
         {
             // Note: If a piece can be captured normally, then it is impossible for a pawn to have moved two
             // spaces (and be open to capture by en passant).
-            // Check en passant -- if the piece next to the destination square is a pawn and the previous move was
-            // a two-space move to that square (assumed to be made by the pawn), then en passant is possible.
+            // Check en passant -- if the previous move was a two-space pawn move past the destination square, then
+            // en passant is possible.
 
-            captured = board.pieceAt(from.row, to.column);
-
-            if (captured &&
-                (captured->type() == PieceTypeId::PAWN) &&
-                (state.move_.from() == Position(to.row + direction, to.column)) &&
-                (state.move_.to() == Position(from.row, to.column)))
+            if ((to == state.enPassant_) && (state.whoseTurn_ == color_))
             {
                 ++count;
             }
@@ -150,21 +68,16 @@ int Pawn::countPossibleMoves(GameState const & state, Position const & from) con
 
         if (captured && (captured->color() != color_))
         {
-            ++count;
+            count += movesTo(to);
         }
         else
         {
             // Note: If a piece can be captured normally, then it is impossible for a pawn to have moved two
             // spaces (and be open to capture by en passant).
-            // Check en passant -- if the piece next to the destination square is a pawn and the previous move was
-            // a two-space move to that square (assumed to be made by the pawn), then en passant is possible.
-
-            captured = board.pieceAt(from.row, to.column);
+            // Check en passant -- if the previous move was a two-space pawn move past the destination square, then
+            // en passant is possible.
 
-            if (captured &&
-                (captured->type() == PieceTypeId::PAWN) &&
-                (state.move_.from() == Position(to.row + direction, to.column)) &&
-                (state.move_.to() == Position(from.row, to.column)))
+            if ((to == state.enPassant_) && (state.whoseTurn_ == color_))
             {
                 ++count;
             }
@@ -178,7 +91,7 @@ int Pawn::countPossibleMoves(GameState const & state, Position const & from) con
 
     if (board.isValidPosition(to) && (board.pieceAt(to) == NO_PIECE))
     {
-        ++count;
+        count += movesTo(to);
 
         // Ahead 2 rows if in its original spot (must be empty)
 
@@ -244,15 +157,8 @@ bool Pawn::isValidMove(GameState const & state, Move const & move) const
 
         // Check en passant
 
-        captured = board.pieceAt(from.row, to.column);
-
-        if (captured &&
-            (captured->type() == PieceTypeId::PAWN) &&
-            (state.move_.from() == Position(to.row + direction, to.column)) &&
-            (state.move_.to() == Position(from.row, to.column)))
-        {
+        if ((to == state.enPassant_) && (state.whoseTurn_ == color_))
             return true;
-        }
     }
 
     // Ahead 2?
@@ -267,3 +173,8 @@ bool Pawn::isValidMove(GameState const & state, Move const & move) const
 
     return false;
 }
+
+int Pawn::movesTo(Position const & to)
+{
+    return (to.row == 0 || to.row == Board::SIZE - 1) ? NUMBER_OF_PROMOTION_TYPES : 1;
+}
@@ -32,7 +32,11 @@ public:
     //!@}
 
 private:
-    static int constexpr MAX_POSSIBLE_MOVES = 6; // The maximum number of possible moves for a pawn
+    static int constexpr MAX_POSSIBLE_MOVES = 12; // The maximum number of possible moves for a pawn (3 promotions x 4 types)
+    static int constexpr NUMBER_OF_PROMOTION_TYPES = 4; // Knight, bishop, rook, and queen
+
+    // Returns the number of moves resulting from a move to 'to' (more than one if it is a promotion)
+    static int movesTo(Position const & to);
 };
 
 #endif // !defined(CHESS_PAWN_H)
@@ -101,86 +101,3 @@ char const * Piece::figurine(PieceTypeId id, Color color)
 {
     return (id != PieceTypeId::INVALID) ? PIECE_TRAITS[(size_t)id].figurine[(size_t)color] : "?";
 }
-
-void Piece::generateSpanMoves(Board const &     board,
-                              Position const &  from,
-                              int               dr,
-                              int               dc,
-                              Piece::MoveList & moves) const
-{
-    // Generate moves until the edge of the board is reached or there is a collision
-
-    Position to(from.row + dr, from.column + dc);
-    while (board.isValidPosition(to))
-    {
-        // If this square has a piece in it then the span is finished.
-        Piece const * piece = board.pieceAt(to);
-        if (piece)
-        {
-            // If it is an opponent's piece, it is also a valid move, so add the capture before quitting.
-            if (piece->color() != color_)
-                moves.emplace_back(this, from, to, true);
-            return;
-        }
-
-        // Add this move
-        moves.emplace_back(this, from, to);
-
-        // Next square in span
-        to.row    += dr;
-        to.column += dc;
-    }
-}
-
-int Piece::countSpanMoves(Board const &    board,
-                          Position const & from,
-                          int              dr,
-                          int              dc) const
-{
-    // Generate moves until the edge of the board is reached or there is a collision
-
-    int count = 0;
-
-    Position to(from.row + dr, from.column + dc);
-    while (board.isValidPosition(to))
-    {
-        // If this square has a piece in it then the span is finished.
-        Piece const * piece = board.pieceAt(to);
-        if (piece)
-        {
-            // If it is an opponent's piece, it is also a valid move, so add the capture before quitting.
-            if (piece->color() != color_)
-                ++count;
-            break;
-        }
-
-        // Add this move
-        ++count;
-
-        // Next square in span
-        to.row    += dr;
-        to.column += dc;
-    }
-
-    return count;
-}
-
-int Piece::countSpanThreats(Board const & board, Position const & from, int dr, int dc) const
-{
-    // Generate moves until the edge of the board is reached or there is a collision
-
-    Position to(from.row + dr, from.column + dc);
-    while (board.isValidPosition(to))
-    {
-        // If this square has a piece in it then the span is finished.
-        Piece const * piece = board.pieceAt(to);
-        if (piece)
-            return 1;
-
-        // Next square in span
-        to.row    += dr;
-        to.column += dc;
-    }
-
-    return 0;
-}
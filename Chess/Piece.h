@@ -3,19 +3,18 @@
 
 #pragma once
 
+#include "Chess/MoveList.h"
 #include "Chess/Types.h"
-#include <vector>
 
 class CBitmap;
 class Board;
-class Move;
 class GameState;
 struct Position;
 
 class Piece
 {
 public:
-    using MoveList = std::vector<Move>;
+    using MoveList = ::MoveList;
 
     Piece(PieceTypeId t, Color c);
     virtual ~Piece()     = default;
@@ -55,22 +54,6 @@ protected:
     char const * symbol_;       // Text symbol for documentation
     char const * figurine_;  // Figurine symbol for documentation
 
-    void generateSpanMoves(Board const &     board,
-                           Position const &  from,
-                           int               dr,
-                           int               dc,
-                           Piece::MoveList & moves) const;
-
-    int countSpanMoves(Board const &    board,
-                       Position const & from,
-                       int              dr,
-                       int              dc) const;
-
-    int countSpanThreats(Board const &    board,
-                         Position const & from,
-                         int              dr,
-                         int              dc) const;
-
 private:
 
     // NO_PIECE followed by white pieces followed by black pieces
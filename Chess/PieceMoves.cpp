@@ -0,0 +1,165 @@
+#include "PieceMoves.h"
+
+#include "GameState.h"
+#include "King.h"
+#include "Move.h"
+#include "Square.h"
+
+namespace
+{
+// Generates the possible moves of every piece of the given type and color
+template <PieceTypeId TYPE>
+void generateAll(Board const & board, Color color, MoveList & moves)
+{
+    Piece const * piece = Piece::get(TYPE, color);
+    BitBoard      froms = board.pieces(TYPE, color);
+    int           r, c;
+    while (froms.popFirst(r, c))
+    {
+        PieceMoves::generate<TYPE>(board, piece, Position(r, c), moves);
+    }
+}
+
+// Generates the possible captures of every piece of the given type and color
+template <PieceTypeId TYPE>
+void generateAllCaptures(Board const & board, Color color, MoveList & moves)
+{
+    Piece const * piece = Piece::get(TYPE, color);
+    BitBoard      froms = board.pieces(TYPE, color);
+    int           r, c;
+    while (froms.popFirst(r, c))
+    {
+        PieceMoves::generateCaptures<TYPE>(board, piece, Position(r, c), moves);
+    }
+}
+
+// Generates the en passant captures of the pawns
+void generateEnPassant(GameState const & state, BitBoard const & pawns, MoveList & moves)
+{
+    // En passant is possible for the pawns that would be attacked by an opponent's pawn on the target square
+    if (!state.enPassant_.isValid())
+        return;
+
+    Color               color    = state.whoseTurn_;
+    BitBoard::PawnColor opponent = (color == Color::WHITE) ? BitBoard::BLACK : BitBoard::WHITE;
+    BitBoard            froms(uint64_t(pawns) & uint64_t(BitBoard::pawnThreatened(opponent, state.enPassant_.index())));
+    int                 r, c;
+    while (froms.popFirst(r, c))
+    {
+        moves.emplace_back(Move::ENPASSANT, color, Position(r, c), state.enPassant_.position(), true);
+    }
+}
+
+// The promotions, in the order they are generated
+PieceTypeId constexpr PROMOTION_TYPES[] = { PieceTypeId::QUEEN, PieceTypeId::KNIGHT, PieceTypeId::ROOK, PieceTypeId::BISHOP };
+
+// Adds a pawn move to each of the destinations. The pawn that moves to a square is at (square - offset).
+void addPawnMoves(Board const & board, Piece const * pawn, BitBoard targets, int offset, MoveList & moves)
+{
+    int i;
+    while (targets.popFirst(i))
+    {
+        Square to(i);
+        moves.emplace_back(pawn, Square(i - offset), to, board.pieceAt(to));
+    }
+}
+
+// Adds all of the promotions for each of the destinations. The pawn that moves to a square is at (square - offset).
+void addPromotions(Board const & board, Color color, BitBoard targets, int offset, bool capture, MoveList & moves)
+{
+    int i;
+    while (targets.popFirst(i))
+    {
+        Position      from     = Square(i - offset).position();
+        Position      to       = Square(i).position();
+        Piece const * captured = capture ? board.pieceAt(to) : NO_PIECE;
+        PieceTypeId   type     = (captured != NO_PIECE) ? captured->type() : PieceTypeId::INVALID;
+        for (auto promotedTo : PROMOTION_TYPES)
+        {
+            moves.push_back(Move::promotion(color, from, to, capture, promotedTo, type));
+        }
+    }
+}
+} // anonymous namespace
+
+void PieceMoves::generatePossibleMoves(GameState const & state, MoveList & moves)
+{
+    Board const & board = state.board_;
+    Color         color = state.whoseTurn_;
+
+    generateAll<PieceTypeId::QUEEN>(board, color, moves);
+    generateAll<PieceTypeId::ROOK>(board, color, moves);
+    generateAll<PieceTypeId::BISHOP>(board, color, moves);
+    generateAll<PieceTypeId::KNIGHT>(board, color, moves);
+
+    // Kings have special moves, so their own generator is called directly (without virtual dispatch)
+    King const * king = static_cast<King const *>(Piece::get(PieceTypeId::KING, color));
+    int          r, c;
+
+    BitBoard kings = board.pieces(PieceTypeId::KING, color);
+    while (kings.popFirst(r, c))
+    {
+        king->King::generatePossibleMoves(state, Position(r, c), moves);
+    }
+
+    BitBoard pawns = board.pieces(PieceTypeId::PAWN, color);
+    generatePawnMoves(board, color, pawns, ~uint64_t(0), true, true, moves);
+    generateEnPassant(state, pawns, moves);
+}
+
+void PieceMoves::generatePossibleCaptures(GameState const & state, MoveList & moves)
+{
+    Board const & board = state.board_;
+    Color         color = state.whoseTurn_;
+
+    generateAllCaptures<PieceTypeId::QUEEN>(board, color, moves);
+    generateAllCaptures<PieceTypeId::ROOK>(board, color, moves);
+    generateAllCaptures<PieceTypeId::BISHOP>(board, color, moves);
+    generateAllCaptures<PieceTypeId::KNIGHT>(board, color, moves);
+
+    // A castle is never a capture, so the king's captures are generated like the other pieces'
+    generateAllCaptures<PieceTypeId::KING>(board, color, moves);
+
+    BitBoard pawns = board.pieces(PieceTypeId::PAWN, color);
+    generatePawnMoves(board, color, pawns, ~uint64_t(0), true, false, moves);
+    generateEnPassant(state, pawns, moves);
+}
+
+void PieceMoves::generatePawnMoves(Board const &   board,
+                                   Color           color,
+                                   BitBoard const & pawns,
+                                   uint64_t        allowed,
+                                   bool            captures,
+                                   bool            quiets,
+                                   MoveList &      moves)
+{
+    BitBoard::PawnColor pawnColor = (BitBoard::PawnColor)color;
+    Piece const *       pawn      = Piece::get(PieceTypeId::PAWN, color);
+    BitBoard            occupied  = board.occupied();
+    uint64_t            lastRow   = BitBoard::rowMask((color == Color::WHITE) ? 0 : Board::SIZE - 1);
+    int                 advance   = BitBoard::pawnAdvance(pawnColor);
+
+    // Pushes to the last row are promotions, which are generated with the captures
+    uint64_t pushes = uint64_t(BitBoard::pawnPushes(pawnColor, pawns, occupied)) & allowed;
+    if (quiets)
+    {
+        addPawnMoves(board, pawn, BitBoard(pushes & ~lastRow), advance, moves);
+        uint64_t doublePushes = uint64_t(BitBoard::pawnDoublePushes(pawnColor, pawns, occupied)) & allowed;
+        addPawnMoves(board, pawn, BitBoard(doublePushes), 2 * advance, moves);
+    }
+
+    if (captures)
+    {
+        addPromotions(board, color, BitBoard(pushes & lastRow), advance, false, moves);
+
+        uint64_t theirs = board.occupied((color == Color::WHITE) ? Color::BLACK : Color::WHITE) & allowed;
+        uint64_t left   = uint64_t(BitBoard::pawnAttacksLeft(pawnColor, pawns)) & theirs;
+        uint64_t right  = uint64_t(BitBoard::pawnAttacksRight(pawnColor, pawns)) & theirs;
+        int      offsetLeft  = BitBoard::pawnAdvanceLeft(pawnColor);
+        int      offsetRight = BitBoard::pawnAdvanceRight(pawnColor);
+        addPawnMoves(board, pawn, BitBoard(left & ~lastRow), offsetLeft, moves);
+        addPawnMoves(board, pawn, BitBoard(right & ~lastRow), offsetRight, moves);
+        addPromotions(board, color, BitBoard(left & lastRow), offsetLeft, true, moves);
+        addPromotions(board, color, BitBoard(right & lastRow), offsetRight, true, moves);
+    }
+}
@@ -0,0 +1,212 @@
+#if !defined(CHESS_PIECEMOVES_H)
+#define CHESS_PIECEMOVES_H
+
+#pragma once
+
+#include "Chess/Board.h"
+#include "Chess/MoveList.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/Types.h"
+
+class GameState;
+
+// Move generation specialized at compile time for each type of piece.
+//
+// The kings, queens, rooks, bishops and knights all move along a fixed set of directions, either one step or until
+// blocked. The functions here are templates on the type of piece, so the directions are compile-time constants and the
+// compiler can unroll and inline the loops for each type. The virtual functions of the pieces are thin wrappers around
+// them. Castles have rules of their own and are generated by King. The pawns of one color are generated all at once
+// with bitboard shifts.
+class PieceMoves
+{
+public:
+    // Generates the possible moves of all of the pieces of the player whose turn it is. Like
+    // Piece::generatePossibleMoves, the moves may leave the king in check.
+    static void generatePossibleMoves(GameState const & state, MoveList & moves);
+
+    // Generates the possible captures (including en passant) and promotions of all of the pieces of the player whose
+    // turn it is. The moves may leave the king in check.
+    static void generatePossibleCaptures(GameState const & state, MoveList & moves);
+
+    // Generates the possible moves of a piece of the given type, excluding castles
+    template <PieceTypeId TYPE>
+    static void generate(Board const & board, Piece const * piece, Position const & from, MoveList & moves);
+
+    // Generates the possible captures of a piece of the given type
+    template <PieceTypeId TYPE>
+    static void generateCaptures(Board const & board, Piece const * piece, Position const & from, MoveList & moves);
+
+    // Generates the moves of all of the given pawns at once, excluding en passant. Only moves to the squares in
+    // 'allowed' are generated. Captures and promotions are generated if 'captures' is true, and the other moves are
+    // generated if 'quiets' is true.
+    static void generatePawnMoves(Board const &   board,
+                                  Color           color,
+                                  BitBoard const & pawns,
+                                  uint64_t        allowed,
+                                  bool            captures,
+                                  bool            quiets,
+                                  MoveList &      moves);
+
+    // Counts the possible moves of a piece of the given type, excluding castles
+    template <PieceTypeId TYPE>
+    static int count(Board const & board, Color color, Position const & from);
+
+    // Counts the pieces (of either color) that a piece of the given type attacks
+    template <PieceTypeId TYPE>
+    static int countThreats(Board const & board, Position const & from);
+
+private:
+    struct Offset
+    {
+        int dr;
+        int dc;
+    };
+
+    // The directions that each type of piece moves in, and whether it slides
+    template <PieceTypeId TYPE>
+    struct Traits;
+
+    static bool isValid(int r, int c) { return (unsigned)r < (unsigned)Board::SIZE && (unsigned)c < (unsigned)Board::SIZE; }
+};
+
+template <>
+struct PieceMoves::Traits<PieceTypeId::KING>
+{
+    static bool constexpr   SLIDES    = false;
+    static Offset constexpr OFFSETS[] = { { -1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, -1 } };
+};
+
+template <>
+struct PieceMoves::Traits<PieceTypeId::QUEEN>
+{
+    static bool constexpr   SLIDES    = true;
+    static Offset constexpr OFFSETS[] = { { -1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, -1 } };
+};
+
+template <>
+struct PieceMoves::Traits<PieceTypeId::BISHOP>
+{
+    static bool constexpr   SLIDES    = true;
+    static Offset constexpr OFFSETS[] = { { -1, 1 }, { 1, 1 }, { 1, -1 }, { -1, -1 } };
+};
+
+template <>
+struct PieceMoves::Traits<PieceTypeId::KNIGHT>
+{
+    static bool constexpr   SLIDES    = false;
+    static Offset constexpr OFFSETS[] = { { -2, -1 }, { -2, 1 }, { -1, 2 }, { 1, 2 }, { 2, -1 }, { 2, 1 }, { -1, -2 }, { 1, -2 } };
+};
+
+template <>
+struct PieceMoves::Traits<PieceTypeId::ROOK>
+{
+    static bool constexpr   SLIDES    = true;
+    static Offset constexpr OFFSETS[] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+};
+
+template <PieceTypeId TYPE>
+void PieceMoves::generate(Board const & board, Piece const * piece, Position const & from, MoveList & moves)
+{
+    Color color = piece->color();
+    for (auto const & o : Traits<TYPE>::OFFSETS)
+    {
+        // Add moves until the edge of the board or a piece is reached. A piece of the opponent can be captured.
+        int r = from.row + o.dr;
+        int c = from.column + o.dc;
+        while (isValid(r, c))
+        {
+            Piece const * target = board.pieceAt(r, c);
+            if (target)
+            {
+                if (target->color() != color)
+                    moves.emplace_back(piece, from, Position(r, c), target);
+                break;
+            }
+            moves.emplace_back(piece, from, Position(r, c), NO_PIECE);
+            if constexpr (!Traits<TYPE>::SLIDES)
+                break;
+            r += o.dr;
+            c += o.dc;
+        }
+    }
+}
+
+template <PieceTypeId TYPE>
+void PieceMoves::generateCaptures(Board const & board, Piece const * piece, Position const & from, MoveList & moves)
+{
+    Color color = piece->color();
+    for (auto const & o : Traits<TYPE>::OFFSETS)
+    {
+        // Skip empty squares until the edge of the board or a piece is reached. A piece of the opponent is captured.
+        int r = from.row + o.dr;
+        int c = from.column + o.dc;
+        while (isValid(r, c))
+        {
+            Piece const * target = board.pieceAt(r, c);
+            if (target)
+            {
+                if (target->color() != color)
+                    moves.emplace_back(piece, from, Position(r, c), target);
+                break;
+            }
+            if constexpr (!Traits<TYPE>::SLIDES)
+                break;
+            r += o.dr;
+            c += o.dc;
+        }
+    }
+}
+
+template <PieceTypeId TYPE>
+int PieceMoves::count(Board const & board, Color color, Position const & from)
+{
+    int n = 0;
+    for (auto const & o : Traits<TYPE>::OFFSETS)
+    {
+        int r = from.row + o.dr;
+        int c = from.column + o.dc;
+        while (isValid(r, c))
+        {
+            Piece const * target = board.pieceAt(r, c);
+            if (target)
+            {
+                if (target->color() != color)
+                    ++n;
+                break;
+            }
+            ++n;
+            if constexpr (!Traits<TYPE>::SLIDES)
+                break;
+            r += o.dr;
+            c += o.dc;
+        }
+    }
+    return n;
+}
+
+template <PieceTypeId TYPE>
+int PieceMoves::countThreats(Board const & board, Position const & from)
+{
+    int n = 0;
+    for (auto const & o : Traits<TYPE>::OFFSETS)
+    {
+        int r = from.row + o.dr;
+        int c = from.column + o.dc;
+        while (isValid(r, c))
+        {
+            if (board.pieceAt(r, c))
+            {
+                ++n;
+                break;
+            }
+            if constexpr (!Traits<TYPE>::SLIDES)
+                break;
+            r += o.dr;
+            c += o.dc;
+        }
+    }
+    return n;
+}
+
+#endif // !defined(CHESS_PIECEMOVES_H)
@@ -2,51 +2,21 @@
 
 #include "GameState.h"
 #include "Move.h"
+#include "PieceMoves.h"
 
 void Queen::generatePossibleMoves(GameState const & state, Position const & from, MoveList & moves) const
 {
-    Board const & board = state.board_;
-
-    moves.reserve(moves.size() + MAX_POSSIBLE_MOVES);
-
-    generateSpanMoves(board, from, (int)Direction::UP,   0,                     moves);
-    generateSpanMoves(board, from, (int)Direction::UP,   (int)Direction::RIGHT, moves);
-    generateSpanMoves(board, from, 0,                    (int)Direction::RIGHT, moves);
-    generateSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::RIGHT, moves);
-    generateSpanMoves(board, from, (int)Direction::DOWN, 0,                     moves);
-    generateSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::LEFT,  moves);
-    generateSpanMoves(board, from, 0,                    (int)Direction::LEFT,  moves);
-    generateSpanMoves(board, from, (int)Direction::UP,   (int)Direction::LEFT,  moves);
+    PieceMoves::generate<PieceTypeId::QUEEN>(state.board_, this, from, moves);
 }
 
 int Queen::countPossibleMoves(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-    count += countSpanMoves(board, from, (int)Direction::UP, 0);
-    count += countSpanMoves(board, from, (int)Direction::UP, (int)Direction::RIGHT);
-    count += countSpanMoves(board, from, 0, (int)Direction::RIGHT);
-    count += countSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::RIGHT);
-    count += countSpanMoves(board, from, (int)Direction::DOWN, 0);
-    count += countSpanMoves(board, from, (int)Direction::DOWN, (int)Direction::LEFT);
-    count += countSpanMoves(board, from, 0, (int)Direction::LEFT);
-    count += countSpanMoves(board, from, (int)Direction::UP, (int)Direction::LEFT);
-    return count;
+    return PieceMoves::count<PieceTypeId::QUEEN>(state.board_, color_, from);
 }
 
 int Queen::countThreats(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-    count += countSpanThreats(board, from, (int)Direction::UP, 0);
-    count += countSpanThreats(board, from, (int)Direction::UP, (int)Direction::RIGHT);
-    count += countSpanThreats(board, from, 0, (int)Direction::RIGHT);
-    count += countSpanThreats(board, from, (int)Direction::DOWN, (int)Direction::RIGHT);
-    count += countSpanThreats(board, from, (int)Direction::DOWN, 0);
-    count += countSpanThreats(board, from, (int)Direction::DOWN, (int)Direction::LEFT);
-    count += countSpanThreats(board, from, 0, (int)Direction::LEFT);
-    count += countSpanThreats(board, from, (int)Direction::UP, (int)Direction::LEFT);
-    return count;
+    return PieceMoves::countThreats<PieceTypeId::QUEEN>(state.board_, from);
 }
 
 bool Queen::isValidMove(GameState const & state, Move const & move) const
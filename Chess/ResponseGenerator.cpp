@@ -1,46 +1,58 @@
 #include "ResponseGenerator.h"
 
 #include "GameState.h"
-#include "Piece.h"
+#include "MoveOrdering.h"
+#include "PieceMoves.h"
+#include <algorithm>
 #include <vector>
 
+ResponseGenerator::ResponseGenerator(std::atomic<bool> const * abort /*= nullptr*/,
+                                     uint64_t *                nodes /*= nullptr*/,
+                                     unsigned                  jitter /*= 0*/,
+                                     MoveOrdering const *      ordering /*= nullptr*/)
+    : abort_(abort)
+    , nodes_(nodes)
+    , jitter_(jitter)
+    , random_(jitter)
+    , ordering_(ordering)
+{
+}
+
 std::vector<GamePlayer::GameState *> ResponseGenerator::operator ()(GamePlayer::GameState const & state, int depth)
 {
-    int constexpr MAX_POSSIBLE_STATES = 147;
+    // If the search has been aborted, every node becomes a leaf so that the search unwinds quickly
+    if (abort_ && abort_->load(std::memory_order_relaxed))
+        return {};
 
-    std::vector<GamePlayer::GameState *> rv;
-    rv.reserve(MAX_POSSIBLE_STATES);
+    GameState const & chessState = static_cast<GameState const &>(state);
+
+    // Generate all the possible moves for the side whose turn it is. All of the moves go into a single buffer for the
+    // node.
+    MoveList moves;
+    PieceMoves::generatePossibleMoves(chessState, moves);
 
-    // For each square on the board, if it contains a piece on the side whose turn it is, generate all the possible
-    // moves for it and add the resulting game states to responses list.
-    Position p(0, 0);
-    for (p.row = 0; p.row < Board::SIZE; p.row++)
+    // Convert the moves into new states and put the new states into the state list
+    std::vector<GamePlayer::GameState *> rv;
+    rv.reserve(moves.size());
+    for (auto const & move : moves)
     {
-        for (p.column = 0; p.column < Board::SIZE; p.column++)
-        {
-            Piece const * piece = static_cast<GameState const &>(state).board_.pieceAt(p);
-
-            if (piece && (piece->color() == static_cast<GameState const &>(state).whoseTurn_))
-            {
-                Piece::MoveList moves;
-                piece->generatePossibleMoves(static_cast<GameState const &>(state), p, moves);
-
-                // Convert the moves into new states and put the new states into the state list
-                for (auto const & move : moves)
-                {
-                    GameState * newState = new GameState(static_cast<GameState const &>(state));
-                    newState->makeMove(move);
-
-#if defined(FEATURE_PRIORITIZED_MOVE_ORDERING)
-                    // Determine the new state's priority
-                    newState.priority_ = prioritize(newState, depth);
-#endif
-
-                    // Save the new state
-                    rv.push_back(newState);
-                }
-            }
-        }
+        GameState * newState = new GameState(chessState);
+        newState->makeMove(move);
+
+        // Determine the new state's priority
+        newState->priority_ = MoveOrdering::priority(ordering_, chessState, move, depth);
+
+        // Save the new state
+        rv.push_back(newState);
     }
+
+    // With jitter, only the responses with equal priorities are shuffled
+    if (jitter_ != 0)
+        std::shuffle(rv.begin(), rv.end(), random_);
+    std::stable_sort(rv.begin(), rv.end(), [] (GamePlayer::GameState const * a, GamePlayer::GameState const * b) {
+                         return a->priority_ > b->priority_;
+                     });
+    if (nodes_)
+        *nodes_ += rv.size();
     return rv;
 }
@@ -3,14 +3,39 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <random>
 #include <vector>
 
+class MoveOrdering;
 namespace GamePlayer { class GameState; }
 
 class ResponseGenerator
 {
 public:
+    // If abort is not null, no responses are generated once it is set. That cuts the search short, and the result of
+    // the search must be discarded, along with the transposition table that it updated. If nodes is not null, the
+    // number of responses generated is added to it. If jitter is not 0, the order of the responses is shuffled using
+    // it as a seed, so that searches of the same tree in parallel take different paths.
+    //
+    // The responses are sorted by priority (highest first). Captures and promotions are always ranked by SEE and
+    // MVV/LVA. If ordering is not null, the priorities of the quiet moves are set from the ordering's killer,
+    // countermove and history tables. Otherwise, the quiet moves are left in the order that they were generated.
+    explicit ResponseGenerator(std::atomic<bool> const * abort    = nullptr,
+                               uint64_t *                nodes    = nullptr,
+                               unsigned                  jitter   = 0,
+                               MoveOrdering const *      ordering = nullptr);
+
+    // Returns the responses to the state. The depth is the ply of the responses.
     std::vector<GamePlayer::GameState *> operator ()(GamePlayer::GameState const & state, int depth);
+
+private:
+    std::atomic<bool> const * abort_;
+    uint64_t *                nodes_;
+    unsigned                  jitter_;
+    std::minstd_rand          random_;
+    MoveOrdering const *      ordering_;
 };
 
 #endif // !defined(CHESS_RESPONSEGENERATOR_H)
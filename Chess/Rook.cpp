@@ -2,37 +2,21 @@
 
 #include "GameState.h"
 #include "Move.h"
+#include "PieceMoves.h"
 
 void Rook::generatePossibleMoves(GameState const & state, Position const & from, MoveList & moves) const
 {
-    Board const & board = state.board_;
-    moves.reserve(moves.size() + MAX_POSSIBLE_MOVES);
-    generateSpanMoves(board, from, (int)Direction::UP,   0, moves); // up
-    generateSpanMoves(board, from, (int)Direction::DOWN, 0, moves); // down
-    generateSpanMoves(board, from, 0, (int)Direction::LEFT, moves); // left
-    generateSpanMoves(board, from, 0, (int)Direction::RIGHT, moves); // right
+    PieceMoves::generate<PieceTypeId::ROOK>(state.board_, this, from, moves);
 }
 
 int Rook::countPossibleMoves(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-    count += countSpanMoves(board, from, (int)Direction::UP, 0); // up
-    count += countSpanMoves(board, from, (int)Direction::DOWN, 0); // down
-    count += countSpanMoves(board, from, 0, (int)Direction::LEFT); // left
-    count += countSpanMoves(board, from, 0, (int)Direction::RIGHT); // right
-    return count;
+    return PieceMoves::count<PieceTypeId::ROOK>(state.board_, color_, from);
 }
 
 int Rook::countThreats(GameState const & state, Position const & from) const
 {
-    Board const & board = state.board_;
-    int           count = 0;
-    count += countSpanThreats(board, from, (int)Direction::UP, 0); // up
-    count += countSpanThreats(board, from, (int)Direction::DOWN, 0); // down
-    count += countSpanThreats(board, from, 0, (int)Direction::LEFT); // left
-    count += countSpanThreats(board, from, 0, (int)Direction::RIGHT); // right
-    return count;
+    return PieceMoves::countThreats<PieceTypeId::ROOK>(state.board_, from);
 }
 
 bool Rook::isValidMove(GameState const & state, Move const & move) const
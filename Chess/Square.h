@@ -0,0 +1,74 @@
+#if !defined(CHESS_SQUARE_H)
+#define CHESS_SQUARE_H
+
+#pragma once
+
+#include "Chess/Position.h"
+#include <cstdint>
+
+// A square on the board, stored as a single byte index (row * 8 + column). Row 0 is rank 8 and column 0 is file a,
+// the same as Position. The index is the bit index used by BitBoard and the square index used by Move.
+class Square
+{
+public:
+    static int constexpr COUNT = 64; // Number of squares on the board
+
+    // Constructs an invalid square
+    constexpr Square() : index_(INVALID_INDEX) {}
+
+    // Constructs a square from its index (0..63)
+    constexpr explicit Square(int index) : index_(uint8_t(index)) {}
+
+    // Constructs a square from a row and column, which must be valid
+    constexpr Square(int r, int c) : index_(uint8_t(r * 8 + c)) {}
+
+    // Converts a Position. An invalid position results in an invalid square.
+    Square(Position const & p)
+        : index_((p.row >= 0 && p.row < 8 && p.column >= 0 && p.column < 8) ? uint8_t(p.row * 8 + p.column) : INVALID_INDEX)
+    {
+    }
+
+    // Returns the index of the square (0..63)
+    constexpr int index() const { return index_; }
+
+    // Returns the row of the square
+    constexpr int row() const { return index_ >> 3; }
+
+    // Returns the column of the square
+    constexpr int column() const { return index_ & 7; }
+
+    // Returns true if this is a square on the board
+    constexpr bool isValid() const { return index_ < COUNT; }
+
+    // Returns the square reflected across the middle of the board (rank 1 <-> rank 8), i.e. the same square from the
+    // other side's point of view
+    constexpr Square flipped() const { return Square(index_ ^ 070); }
+
+    // Returns the square reflected across the middle of the board (file a <-> file h)
+    constexpr Square mirrored() const { return Square(index_ ^ 007); }
+
+    // Returns the square as a Position (an invalid position if the square is invalid)
+    Position position() const { return isValid() ? Position(row(), column()) : Position(); }
+
+    // Returns the notation for the square ("-" if invalid)
+    std::string notation() const { return position().notation(); }
+
+private:
+    static uint8_t constexpr INVALID_INDEX = 0xff;
+
+    uint8_t index_;
+};
+
+static_assert(sizeof(Square) == 1, "Square is expected to be 8 bits");
+
+inline constexpr bool operator ==(Square const & a, Square const & b)
+{
+    return a.index() == b.index();
+}
+
+inline constexpr bool operator !=(Square const & a, Square const & b)
+{
+    return !(a == b);
+}
+
+#endif // !defined(CHESS_SQUARE_H)
@@ -0,0 +1,252 @@
+#include "StagedMoveGenerator.h"
+
+#include "GameState.h"
+#include "MoveGenerator.h"
+#include "MoveOrdering.h"
+#include "Piece.h"
+#include "StaticEvaluator.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+// Piece values used for MVV/LVA ordering, indexed by PieceTypeId. The king is never a victim, and as an attacker it is
+// the least desirable piece to capture with because it can't be recaptured.
+int constexpr ORDERING_VALUES[] = { 100, 9, 3, 3, 5, 1 };
+
+int orderingValue(PieceTypeId type)
+{
+    assert(type != PieceTypeId::INVALID);
+    return ORDERING_VALUES[(int)type];
+}
+
+// Returns true if the move neither captures nor promotes
+bool isQuiet(GameState const & state, Move const & move)
+{
+    if (move.isPromotion() || move.isEnPassant())
+        return false;
+    if (move.isKingSideCastle() || move.isQueenSideCastle())
+        return true;
+    return state.board_.pieceAt(move.to()) == NO_PIECE;
+}
+
+// Sorts the moves by their scores, highest first. An insertion sort is used since the lists are short, and it is
+// stable, which keeps the order deterministic.
+void sortByScore(MoveList & moves, int * scores)
+{
+    for (size_t i = 1; i < moves.size(); ++i)
+    {
+        Move   m = moves[i];
+        int    s = scores[i];
+        size_t j = i;
+        for (; j > 0 && scores[j - 1] < s; --j)
+        {
+            moves[j]  = moves[j - 1];
+            scores[j] = scores[j - 1];
+        }
+        moves[j]  = m;
+        scores[j] = s;
+    }
+}
+} // anonymous namespace
+
+StagedMoveGenerator::StagedMoveGenerator(GameState const &    state,
+                                         Move const *         hashMove /*= nullptr*/,
+                                         Move const *         killers /*= nullptr*/,
+                                         int                  killerCount /*= 0*/,
+                                         MoveOrdering const * ordering /*= nullptr*/)
+    : state_(state)
+    , ordering_(ordering)
+    , stage_(HASH_MOVE)
+    , generated_(false)
+    , hasHashMove_(hashMove != nullptr)
+    , killerCount_(0)
+    , next_(0)
+{
+    assert(killerCount >= 0 && killerCount <= MAX_KILLERS);
+    if (hashMove)
+        hashMove_ = *hashMove;
+    for (int i = 0; i < killerCount; ++i)
+    {
+        killers_[killerCount_++] = killers[i];
+    }
+}
+
+bool StagedMoveGenerator::next(Move & move)
+{
+    for (;;)
+    {
+        switch (stage_)
+        {
+        case HASH_MOVE:
+            // The hash move could come from a different position with the same hash, so it must be verified. Nothing
+            // else is generated yet, so if the hash move produces a cutoff, no other moves are generated at all.
+            stage_       = CAPTURES;
+            hasHashMove_ = hasHashMove_ && MoveGenerator::isLegal(state_, hashMove_);
+            if (hasHashMove_)
+            {
+                move = hashMove_;
+                return true;
+            }
+            break;
+
+        case CAPTURES:
+            if (!generated_)
+                generate(MoveGenerator::CAPTURES);
+            if (nextGenerated(move))
+                return true;
+
+            // Killers come from sibling nodes, so they must be verified. Only quiet killers are kept because the
+            // captures have already been returned (or deferred).
+            stage_     = KILLERS;
+            generated_ = false;
+            {
+                int n = 0;
+                for (int i = 0; i < killerCount_; ++i)
+                {
+                    Move const & killer = killers_[i];
+                    bool         duplicate = std::find(killers_, killers_ + n, killer) != killers_ + n;
+                    if (!duplicate && !alreadyReturned(killer) && isQuiet(state_, killer) &&
+                        MoveGenerator::isLegal(state_, killer))
+                        killers_[n++] = killer;
+                }
+                killerCount_ = n;
+            }
+            next_ = 0;
+            break;
+
+        case KILLERS:
+            if (next_ < (size_t)killerCount_)
+            {
+                move = killers_[next_++];
+                return true;
+            }
+            stage_ = QUIETS;
+            break;
+
+        case QUIETS:
+            if (!generated_)
+                generate(MoveGenerator::QUIETS);
+            if (nextGenerated(move))
+                return true;
+            stage_     = BAD_CAPTURES;
+            generated_ = false;
+            break;
+
+        case BAD_CAPTURES:
+            if (!generated_)
+            {
+                moves_     = badCaptures_;
+                next_      = 0;
+                generated_ = true;
+            }
+            if (nextGenerated(move))
+                return true;
+            stage_ = DONE;
+            break;
+
+        case DONE:
+            return false;
+        }
+    }
+}
+
+int StagedMoveGenerator::mvvLva(GameState const & state, Move const & move)
+{
+    int score = 0;
+    if (move.isEnPassant())
+    {
+        score = orderingValue(PieceTypeId::PAWN) * 16 - orderingValue(PieceTypeId::PAWN);
+    }
+    else
+    {
+        Piece const * victim = state.board_.pieceAt(move.to());
+        if (victim != NO_PIECE)
+            score = orderingValue(victim->type()) * 16 - orderingValue(move.movedType());
+    }
+
+    // A promotion gains the value of the promoted piece (less the pawn)
+    if (move.isPromotion())
+        score += (orderingValue(move.promotedTo()) - orderingValue(PieceTypeId::PAWN)) * 16;
+
+    return score;
+}
+
+void StagedMoveGenerator::generate(MoveGenerator::Kind kind)
+{
+    moves_.clear();
+    next_      = 0;
+    generated_ = true;
+    MoveGenerator::generateLegalMoves(state_, moves_, kind);
+
+    // The scores are computed once rather than in each comparison
+    int scores[MoveList::CAPACITY];
+    if (kind == MoveGenerator::CAPTURES)
+    {
+        int    badScores[MoveList::CAPACITY];
+        size_t n = 0;
+        for (size_t i = 0; i < moves_.size(); ++i)
+        {
+            Move const & move  = moves_[i];
+            int          score = mvvLva(state_, move);
+            if (ordering_)
+            {
+                int see = StaticEvaluator::see(state_, move);
+                score += see * MoveOrdering::SEE_SCALE;
+                if (see < 0)
+                {
+                    badScores[badCaptures_.size()] = score;
+                    badCaptures_.push_back(move);
+                    continue;
+                }
+            }
+            scores[n]   = score;
+            moves_[n++] = move;
+        }
+        while (moves_.size() > n)
+            moves_.pop_back();
+        sortByScore(moves_, scores);
+        sortByScore(badCaptures_, badScores);
+    }
+    else if (ordering_)
+    {
+        for (size_t i = 0; i < moves_.size(); ++i)
+        {
+            scores[i] = ordering_->quietPriority(state_, moves_[i]);
+        }
+        sortByScore(moves_, scores);
+    }
+}
+
+bool StagedMoveGenerator::nextGenerated(Move & move)
+{
+    while (next_ < moves_.size())
+    {
+        Move const & m = moves_[next_++];
+        if (!alreadyReturned(m))
+        {
+            move = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StagedMoveGenerator::alreadyReturned(Move const & move) const
+{
+    if (hasHashMove_ && move == hashMove_)
+        return true;
+
+    // The killers are only known to be valid after the KILLERS stage has begun
+    if (stage_ > KILLERS)
+    {
+        for (int i = 0; i < killerCount_; ++i)
+        {
+            if (move == killers_[i])
+                return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+#if !defined(CHESS_STAGEDMOVEGENERATOR_H)
+#define CHESS_STAGEDMOVEGENERATOR_H
+
+#pragma once
+
+#include "Chess/Move.h"
+#include "Chess/MoveGenerator.h"
+#include "Chess/MoveList.h"
+#include <cstddef>
+
+class GameState;
+class MoveOrdering;
+
+// Generates the legal moves of a node in stages, in the order that is most likely to produce an early cutoff.
+//
+// The stages are: the hash move, the captures and promotions (most valuable victim first, then least valuable
+// attacker), the killer moves, and finally the remaining quiet moves. A stage is generated only when the previous
+// stage is exhausted, so if a move in an early stage produces a cutoff, the work of generating the later stages is
+// never done. The hash move and killer moves are verified to be legal before they are returned, and they are not
+// returned again by a later stage.
+//
+// If a MoveOrdering is given, the captures and promotions are ordered by static exchange evaluation instead (with ties
+// broken by MVV/LVA), those that lose material are deferred until after the quiet moves, and the quiet moves are
+// ordered by the countermove and history tables.
+class StagedMoveGenerator
+{
+public:
+    // The maximum number of killer moves
+    static int constexpr MAX_KILLERS = 2;
+
+    // Constructor
+    StagedMoveGenerator(GameState const &    state,
+                        Move const *         hashMove    = nullptr,
+                        Move const *         killers     = nullptr,
+                        int                  killerCount = 0,
+                        MoveOrdering const * ordering    = nullptr);
+
+    // Returns the next move in the node, or false if there are no more moves
+    bool next(Move & move);
+
+    // Returns the MVV/LVA score of a capture or promotion. Higher scores are searched first.
+    static int mvvLva(GameState const & state, Move const & move);
+
+private:
+    // The stages, in order
+    enum Stage
+    {
+        HASH_MOVE,
+        CAPTURES,
+        KILLERS,
+        QUIETS,
+        BAD_CAPTURES,
+        DONE
+    };
+
+    // Generates the moves of a stage into moves_
+    void generate(MoveGenerator::Kind kind);
+
+    // Returns the next generated move that has not already been returned, or false if there are none
+    bool nextGenerated(Move & move);
+
+    // Returns true if the move was already returned by an earlier stage
+    bool alreadyReturned(Move const & move) const;
+
+    GameState const &    state_;
+    MoveOrdering const * ordering_;
+    Stage                stage_;
+    bool                 generated_;    // True if the moves of the current stage have been generated
+    bool                 hasHashMove_;
+    Move                 hashMove_;
+    Move                 killers_[MAX_KILLERS];
+    int                  killerCount_;
+    MoveList             moves_;        // The moves of the current stage
+    MoveList             badCaptures_;  // Captures that lose material, deferred until after the quiet moves
+    size_t               next_;         // Index of the next move in moves_
+};
+
+#endif // !defined(CHESS_STAGEDMOVEGENERATOR_H)
@@ -4,6 +4,7 @@
 #include "Move.h"
 #include "Piece.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace
@@ -83,6 +84,81 @@ float evaluate(GameState::CastleStatus castleStatus)
 
     return value;
 }
+
+#if defined(FEATURE_POPCOUNT_MOBILITY)
+// Returns the number of pawn moves to the given squares. A move to the last row counts once for each promotion.
+int pawnMovesTo(uint64_t targets, uint64_t lastRow)
+{
+    return BitBoard(targets & ~lastRow).count() + 4 * BitBoard(targets & lastRow).count();
+}
+
+// Counts the possible moves and the threats of all the pieces of one color. The results are the same as the sums of
+// Piece::countPossibleMoves and Piece::countThreats over the pieces. The threats and the moves of the queens, rooks,
+// bishops and knights are taken from the attacks of the state, and the moves of the king and the pawns are added.
+void countMobilityAndThreats(GameState const & s, Color color, int & mobility, int & threats)
+{
+    GameState::AttackInfo const & info     = s.attackInfo();
+    Board const &                 board    = s.board_;
+    BitBoard                      occupied = board.occupied();
+    uint64_t                      theirs   = uint64_t(occupied) & ~uint64_t(board.occupied(color));
+
+    mobility = info.mobility_[(int)color];
+    threats  = info.threats_[(int)color];
+
+    // The king's mobility includes castles, which have rules of their own, so the king counts its own moves
+    Piece const * king = Piece::get(PieceTypeId::KING, color);
+    for (int i : board.pieces(PieceTypeId::KING, color))
+    {
+        mobility += king->countPossibleMoves(s, Square(i).position());
+    }
+
+    // The pawns are counted all at once. Each shift moves every pawn to a different square, so counting the shifted
+    // squares counts the moves of each pawn.
+    BitBoard::PawnColor pawnColor = (BitBoard::PawnColor)color;
+    BitBoard            pawns     = board.pieces(PieceTypeId::PAWN, color);
+    uint64_t            lastRow   = BitBoard::rowMask((color == Color::WHITE) ? 0 : Board::SIZE - 1);
+    uint64_t            left      = BitBoard::pawnAttacksLeft(pawnColor, pawns);
+    uint64_t            right     = BitBoard::pawnAttacksRight(pawnColor, pawns);
+    uint64_t            one       = BitBoard::pawnPushes(pawnColor, pawns, occupied);
+    uint64_t            two       = BitBoard::pawnDoublePushes(pawnColor, pawns, occupied);
+
+    mobility += pawnMovesTo(left & theirs, lastRow) + pawnMovesTo(right & theirs, lastRow);
+    mobility += pawnMovesTo(one, lastRow) + BitBoard(two).count();
+    if (s.whoseTurn_ == color && s.enPassant_.isValid())
+    {
+        uint64_t target = uint64_t(1) << s.enPassant_.index();
+        mobility += BitBoard(left & target).count() + BitBoard(right & target).count();
+    }
+}
+#endif // defined(FEATURE_POPCOUNT_MOBILITY)
+
+// Attackers in the order they are used in an exchange, least valuable first
+PieceTypeId constexpr EXCHANGE_ORDER[] =
+{
+    PieceTypeId::PAWN, PieceTypeId::KNIGHT, PieceTypeId::BISHOP, PieceTypeId::ROOK, PieceTypeId::QUEEN, PieceTypeId::KING
+};
+
+// Returns the property value of a piece in hundredths of a pawn
+int exchangeValue(PieceTypeId type)
+{
+    return int(s_ValuesByPiece[(int)type].property * 100.0f / PAWN_PROPERTY_VALUE + 0.5f);
+}
+
+// Finds the least valuable of the attackers. Returns false if there are none.
+bool leastValuableAttacker(Board const & board, uint64_t attackers, Color color, PieceTypeId & type, uint64_t & square)
+{
+    for (PieceTypeId t : EXCHANGE_ORDER)
+    {
+        uint64_t pieces = attackers & uint64_t(board.pieces(t, color));
+        if (pieces)
+        {
+            type   = t;
+            square = pieces & (~pieces + 1);
+            return true;
+        }
+    }
+    return false;
+}
 } // anonymous namespace
 
 float StaticEvaluator::evaluate(GamePlayer::GameState const & state) const
@@ -109,61 +185,74 @@ float StaticEvaluator::evaluate(GamePlayer::GameState const & state) const
     // The value of pawn advancement is found by adding the row of each pawn (by color)
     float totalAdvancementValue = 0.0f;
 
-    // Compute the difference in values of the pieces on the board
-    for (int row = 0; row < Board::SIZE; ++row)
+    // Compute the difference in values of the pieces on the board. Only the occupied squares are visited.
+    for (int i : s.board_.occupied())
     {
-        for (int column = 0; column < Board::SIZE; ++column)
+        Square        square(i);
+        int           row    = square.row();
+        int           column = square.column();
+        Piece const * p      = s.board_.pieceAt(square);
+        Position      position{ row, column };
+
+        Color       color = p->color();
+        PieceTypeId type  = p->type();
+
+        // Compute the checkmate value
+        if (type == PieceTypeId::KING)
+            totalCheckmateValue += (color == Color::WHITE) ? CHECKMATE_VALUE : -CHECKMATE_VALUE;
+
+        // Compute pawn advancement value
+        if (type == PieceTypeId::PAWN)
+            totalAdvancementValue = float((color == Color::WHITE) ? Board::SIZE - row : -row);
+
+        // Compute the property difference
         {
-            Piece const * p = s.board_.pieceAt(row, column);
-            Position      position{ row, column };
-
-            if (p)
-            {
-                Color       color = p->color();
-                PieceTypeId type  = p->type();
-
-                // Compute the checkmate value
-                if (type == PieceTypeId::KING)
-                    totalCheckmateValue += (color == Color::WHITE) ? CHECKMATE_VALUE : -CHECKMATE_VALUE;
-
-                // Compute pawn advancement value
-                if (type == PieceTypeId::PAWN)
-                    totalAdvancementValue = float((color == Color::WHITE) ? Board::SIZE - row : -row);
-
-                // Compute the property difference
-                {
-                    float propertyValue = s_ValuesByPiece[(int)type].property;
-                    if (color != Color::WHITE)
-                        propertyValue = -propertyValue;
-                    totalPropertyValue += propertyValue;
-                }
-
-                // Compute the mobility difference
-                {
-                    float mobilityValue = (float)p->countPossibleMoves(s, position);
-                    if (color != Color::WHITE)
-                        mobilityValue = -mobilityValue;
-                    totalMobilityValue += mobilityValue;
-                }
-
-                // Compute the position difference
-                {
-                    float positionValue = s_ValuesByPiece[(int)type].position * s_PositionValues[row][column];
-                    if (color != Color::WHITE)
-                        positionValue = -positionValue;
-                    totalPositionValue += positionValue;
-                }
-
-                // Compute threat difference
-                {
-                    float threatValue = (float)p->countThreats(s, position);
-                    if (color != Color::WHITE)
-                        threatValue = -threatValue;
-                    totalThreatValue += threatValue;
-                }
-            }
+            float propertyValue = s_ValuesByPiece[(int)type].property;
+            if (color != Color::WHITE)
+                propertyValue = -propertyValue;
+            totalPropertyValue += propertyValue;
         }
+
+#if !defined(FEATURE_POPCOUNT_MOBILITY)
+        // Compute the mobility difference
+        {
+            float mobilityValue = (float)p->countPossibleMoves(s, position);
+            if (color != Color::WHITE)
+                mobilityValue = -mobilityValue;
+            totalMobilityValue += mobilityValue;
+        }
+#endif
+
+        // Compute the position difference
+        {
+            float positionValue = s_ValuesByPiece[(int)type].position * s_PositionValues[row][column];
+            if (color != Color::WHITE)
+                positionValue = -positionValue;
+            totalPositionValue += positionValue;
+        }
+
+#if !defined(FEATURE_POPCOUNT_MOBILITY)
+        // Compute threat difference
+        {
+            float threatValue = (float)p->countThreats(s, position);
+            if (color != Color::WHITE)
+                threatValue = -threatValue;
+            totalThreatValue += threatValue;
+        }
+#endif
+    }
+
+#if defined(FEATURE_POPCOUNT_MOBILITY)
+    // Compute the mobility and threat differences for all the pieces of each side at once
+    {
+        int whiteMobility, whiteThreats;
+        int blackMobility, blackThreats;
+        countMobilityAndThreats(s, Color::WHITE, whiteMobility, whiteThreats);
+        countMobilityAndThreats(s, Color::BLACK, blackMobility, blackThreats);
+        totalMobilityValue = float(whiteMobility - blackMobility);
+        totalThreatValue   = float(whiteThreats - blackThreats);
     }
+#endif
 
     float castleStatusValue = ::evaluate(s.castleStatus_);
 
@@ -197,6 +286,72 @@ float StaticEvaluator::evaluate(GamePlayer::GameState const & state) const
     return value;
 }
 
+int StaticEvaluator::see(GameState const & state, Move const & move)
+{
+    if (move.isKingSideCastle() || move.isQueenSideCastle())
+        return 0;
+
+    Board const & board    = state.board_;
+    Position      from     = move.from();
+    Position      to       = move.to();
+    Color         us       = move.color();
+    uint64_t      occupied = uint64_t(board.occupied()) & ~(uint64_t(1) << Square(from).index());
+
+    // The first capture is made by the moving piece. An en passant capture removes a pawn that is not on the
+    // destination square.
+    int gains[32];
+    gains[0] = 0;
+    if (move.isEnPassant())
+    {
+        gains[0]  = exchangeValue(PieceTypeId::PAWN);
+        occupied &= ~(uint64_t(1) << Square(Position(from.row, to.column)).index());
+    }
+    else if (board.pieceAt(to) != NO_PIECE)
+    {
+        gains[0] = exchangeValue(board.pieceAt(to)->type());
+    }
+
+    // The value of the piece standing on the square, which is what the next capture gains
+    int onSquare = exchangeValue(move.movedType());
+    if (move.isPromotion())
+    {
+        onSquare  = exchangeValue(move.promotedTo());
+        gains[0] += onSquare - exchangeValue(PieceTypeId::PAWN);
+    }
+
+    // Play out the exchange. The pieces that have captured are removed from the occupied squares, so the sliders
+    // behind them are found by the next scan.
+    Color side  = (us == Color::WHITE) ? Color::BLACK : Color::WHITE;
+    int   depth = 0;
+    while (depth < (int)(sizeof(gains) / sizeof(gains[0])) - 1)
+    {
+        uint64_t    attackers = uint64_t(state.attackersTo(to, side, BitBoard(occupied))) & occupied;
+        PieceTypeId type;
+        uint64_t    square;
+        if (!leastValuableAttacker(board, attackers, side, type, square))
+            break;
+
+        // The king can only capture if the square is not defended
+        Color other = (side == Color::WHITE) ? Color::BLACK : Color::WHITE;
+        if (type == PieceTypeId::KING && (uint64_t(state.attackersTo(to, other, BitBoard(occupied))) & occupied) != 0)
+            break;
+
+        ++depth;
+        gains[depth] = onSquare - gains[depth - 1];
+        onSquare     = exchangeValue(type);
+        occupied    &= ~square;
+        side         = other;
+    }
+
+    // Each player only continues the exchange if doing so is better than stopping
+    while (depth > 0)
+    {
+        --depth;
+        gains[depth] = -std::max(-gains[depth], gains[depth + 1]);
+    }
+    return gains[0];
+}
+
 #if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
 
 // This function returns the change in the value of the board *** BY COLOR ***.
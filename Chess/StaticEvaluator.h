@@ -5,6 +5,7 @@
 
 #include "GamePlayer/StaticEvaluator.h"
 
+class GameState;
 class Move;
 class Piece;
 struct Position;
@@ -29,6 +30,11 @@ public:
 
     //!@}
 
+    // Returns the material gained by the player making a capture or promotion when the exchange on the destination
+    // square is played out, in hundredths of a pawn. The players capture with their least valuable attacker first and
+    // either one can stop capturing when it is ahead, so a negative value means the move loses material.
+    static int see(GameState const & state, Move const & move);
+
 #if defined(FEATURE_INCREMENTAL_STATIC_EVALUATION)
     // Returns a value for the game state based on the move and its current value
     static float incremental(Move const &            move,
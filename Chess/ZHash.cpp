@@ -34,14 +34,10 @@ ZHash::ZHash(Board const & board,
 {
     value_ = EMPTY;
 
-    for (int i = 0; i < Board::SIZE; ++i)
+    for (int i : board.occupied())
     {
-        for (int j = 0; j < Board::SIZE; ++j)
-        {
-            Piece const * const piece = board.pieceAt(i, j);
-            if (piece)
-                add(piece, Position(i, j));
-        }
+        Square square(i);
+        add(board.pieceAt(square), square);
     }
 
     if (whoseTurn != Color::WHITE)
@@ -58,33 +54,33 @@ ZHash::ZHash(Board const & board,
 }
 
 //! @param	piece      Pointer to the piece to add.
-//! @param	position   The position where the piece is placed.
+//! @param	square     The square where the piece is placed.
 //!
 //! @return	Reference to this ZHash object.
-ZHash & ZHash::add(Piece const * piece, Position const & position)
+ZHash & ZHash::add(Piece const * piece, Square square)
 {
     assert(piece);
-    value_ ^= zValueTable_.pieceValue((int)piece->color(), (int)piece->type(), position.row, position.column);
+    value_ ^= zValueTable_.pieceValue((int)piece->color(), (int)piece->type(), square.index());
     return *this;
 }
 
 //! @param	piece      Pointer to the piece to remove.
-//! @param	position   The position from which the piece is removed.
+//! @param	square     The square from which the piece is removed.
 //!
 //! @return	Reference to this ZHash object.
-ZHash & ZHash::remove(Piece const * piece, Position const & position)
+ZHash & ZHash::remove(Piece const * piece, Square square)
 {
     assert(piece);
-    value_ ^= zValueTable_.pieceValue((int)piece->color(), (int)piece->type(), position.row, position.column);
+    value_ ^= zValueTable_.pieceValue((int)piece->color(), (int)piece->type(), square.index());
     return *this;
 }
 
 //! @param	piece      Pointer to the piece to move.
-//! @param	from       The starting position.
-//! @param	to         The destination position.
+//! @param	from       The starting square.
+//! @param	to         The destination square.
 //!
 //! @return	Reference to this ZHash object.
-ZHash & ZHash::move(Piece const * piece, Position const & from, Position const & to)
+ZHash & ZHash::move(Piece const * piece, Square from, Square to)
 {
     assert(piece);
     remove(piece, from);
@@ -146,14 +142,11 @@ ZHash::ZValueTable::ZValueTable()
 
     for (int i = 0; i < NUMBER_OF_COLORS; ++i)
     {
-        for (int j = 0; j < Board::SIZE; ++j)
+        for (int j = 0; j < Square::COUNT; ++j)
         {
-            for (int k = 0; k < Board::SIZE; ++k)
+            for (int m = 0; m < NUMBER_OF_PIECE_TYPES; ++m)
             {
-                for (int m = 0; m < NUMBER_OF_PIECE_TYPES; ++m)
-                {
-                    pieceValues_[i][j][k][m] = rng();
-                }
+                pieceValues_[i][j][m] = rng();
             }
         }
     }
@@ -184,13 +177,12 @@ ZHash::ZValueTable::ZValueTable()
     turnValue_ = rng();
 }
 
-ZHash::Z ZHash::ZValueTable::pieceValue(int color, int type, int row, int column) const
+ZHash::Z ZHash::ZValueTable::pieceValue(int color, int type, int square) const
 {
     assert(color >= 0 && color < NUMBER_OF_COLORS);
     assert(type >= 0 && type < NUMBER_OF_PIECE_TYPES);
-    assert(row >= 0 && row < Board::SIZE);
-    assert(column >= 0 && column < Board::SIZE);
-    return pieceValues_[color][row][column][type];
+    assert(square >= 0 && square < Square::COUNT);
+    return pieceValues_[color][square][type];
 }
 
 ZHash::Z ZHash::ZValueTable::castleValue(int castle) const
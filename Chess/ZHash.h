@@ -20,6 +20,7 @@
 #define ZHash_h__
 
 #include "Board.h"
+#include "Square.h"
 #include "Types.h"
 #include <cstdint>
 
@@ -75,13 +76,13 @@ public:
     Z value() const { return value_; }
 
     //! Adds a piece. Returns a reference to itself
-    ZHash & add(Piece const * piece, Position const & position);
+    ZHash & add(Piece const * piece, Square square);
 
     //! Removes a piece. Returns a reference to itself.
-    ZHash & remove(Piece const * piece, Position const & position);
+    ZHash & remove(Piece const * piece, Square square);
 
     //! Removes a piece at the 'from' position and adds it to the 'to' position
-    ZHash & move(Piece const * piece, Position const & from, Position const & to);
+    ZHash & move(Piece const * piece, Square from, Square to);
 
     //! Changes whose turn. Returns a reference to itself.
     ZHash & turn();
@@ -124,7 +125,7 @@ public:
     ZValueTable();
 
     // Returns the hash value for a piece on the board
-    Z pieceValue(int color, int type, int row, int column) const;
+    Z pieceValue(int color, int type, int square) const;
 
     // Returns the hash value for a particular castle availability
     Z castleValue(int which) const;
@@ -140,7 +141,7 @@ public:
 
 private:
 
-    Z pieceValues_[NUMBER_OF_COLORS][Board::SIZE][Board::SIZE][NUMBER_OF_PIECE_TYPES];
+    Z pieceValues_[NUMBER_OF_COLORS][Square::COUNT][NUMBER_OF_PIECE_TYPES];
     Z castleValues_[4];
     Z enPassantValues_[NUMBER_OF_COLORS][Board::SIZE];
     Z fiftyValue_;
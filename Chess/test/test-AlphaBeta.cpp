@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include "Chess/AlphaBeta.h"
+#include "Chess/GameState.h"
+#include "Chess/Position.h"
+#include "Chess/StaticEvaluator.h"
+
+#include <memory>
+
+namespace
+{
+char const * const POSITIONS[] =
+{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+} // anonymous namespace
+
+TEST(AlphaBetaTest, MateInOne)
+{
+    std::shared_ptr<StaticEvaluator> evaluator(new StaticEvaluator);
+    AlphaBeta                        search(evaluator);
+
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"));
+    float                      value;
+    std::shared_ptr<GameState> response = search.search(state, 2, nullptr, &value);
+    ASSERT_NE(response, nullptr);
+    EXPECT_EQ(response->move_.from(), Position(7, 0));
+    EXPECT_EQ(response->move_.to(), Position(0, 0));
+    EXPECT_EQ(value, StaticEvaluator::CHECKMATE_VALUE - 1);
+}
+
+TEST(AlphaBetaTest, NoLegalMoves)
+{
+    std::shared_ptr<StaticEvaluator> evaluator(new StaticEvaluator);
+    AlphaBeta                        search(evaluator);
+
+    // Checkmate
+    GameState mated;
+    ASSERT_TRUE(mated.initializeFromFen("R5k1/5ppp/8/8/8/8/8/6K1 b - - 1 1"));
+    EXPECT_EQ(search.search(mated, 2), nullptr);
+
+    // Stalemate
+    GameState stalemated;
+    ASSERT_TRUE(stalemated.initializeFromFen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"));
+    EXPECT_EQ(search.search(stalemated, 2), nullptr);
+}
+
+TEST(AlphaBetaTest, Quiescence)
+{
+    std::shared_ptr<StaticEvaluator> evaluator(new StaticEvaluator);
+    AlphaBeta                        search(evaluator);
+
+    // Taking the pawn on d5 loses the queen to the pawn on c6, which only the quiescence search sees at depth 1
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1"));
+    std::shared_ptr<GameState> response = search.search(state, 1);
+    ASSERT_NE(response, nullptr);
+    EXPECT_NE(response->move_.to(), Position(3, 3));
+    EXPECT_GT(search.statistics().qnodes, 0);
+}
+
+TEST(AlphaBetaTest, QuiescenceInCheck)
+{
+    std::shared_ptr<StaticEvaluator> evaluator(new StaticEvaluator);
+    AlphaBeta                        search(evaluator);
+
+    // After the rook's check, black can't stand pat, so even a search of depth 1 sees that black has no evasions
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1"));
+    float                      value;
+    std::shared_ptr<GameState> response = search.search(state, 1, nullptr, &value);
+    ASSERT_NE(response, nullptr);
+    EXPECT_EQ(response->move_.to(), Position(0, 0));
+    EXPECT_EQ(value, StaticEvaluator::CHECKMATE_VALUE - 1);
+}
+
+TEST(AlphaBetaTest, ParallelMatchesSequential)
+{
+    std::shared_ptr<StaticEvaluator> evaluator(new StaticEvaluator);
+
+    for (auto fen : POSITIONS)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(fen));
+
+        // The selective search depends on the bounds that each thread sees, so by default it is turned off with more
+        // than one thread
+        AlphaBeta                  sequential(evaluator, 1, 2, AlphaBeta::Options::exact());
+        float                      expectedValue;
+        std::shared_ptr<GameState> expected = sequential.search(state, 3, nullptr, &expectedValue);
+        ASSERT_NE(expected, nullptr);
+        EXPECT_EQ(sequential.statistics().splits, 0);
+
+        AlphaBeta                  parallel(evaluator, 4, 1);
+        float                      value;
+        std::shared_ptr<GameState> actual = parallel.search(state, 3, nullptr, &value);
+        ASSERT_NE(actual, nullptr);
+        EXPECT_EQ(value, expectedValue) << fen;
+        EXPECT_EQ(actual->move_, expected->move_) << fen;
+        EXPECT_GT(parallel.statistics().splits, 0);
+        EXPECT_GT(parallel.statistics().tasks, 0);
+        EXPECT_EQ(parallel.statistics().nullMoveCutoffs, 0);
+        EXPECT_EQ(parallel.statistics().reductions, 0);
+    }
+}
+
+TEST(AlphaBetaTest, SelectiveSearch)
+{
+    std::shared_ptr<StaticEvaluator> evaluator(new StaticEvaluator);
+
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen(POSITIONS[3]));
+
+    // Both searches deepen iteratively, as ComputerPlayer does, so that the history is filled by the earlier depths
+    AlphaBeta full(evaluator, 1, 2, AlphaBeta::Options::exact());
+    AlphaBeta selective(evaluator);
+    for (int depth = 1; depth <= 6; ++depth)
+    {
+        ASSERT_NE(full.search(state, depth), nullptr);
+        ASSERT_NE(selective.search(state, depth), nullptr);
+    }
+    EXPECT_GT(selective.statistics().nullMoveCutoffs, 0);
+    EXPECT_GT(selective.statistics().reductions, 0);
+    EXPECT_LT(selective.statistics().nodes, full.statistics().nodes);
+
+    // With the move ordering, most cutoffs come from the first move
+    EXPECT_GT(full.statistics().firstMoveCutoffs * 2, full.statistics().cutoffs);
+
+    // A mate is still found
+    GameState mate;
+    ASSERT_TRUE(mate.initializeFromFen("6k1/5ppp/8/8/8/8/1Q6/1R4K1 w - - 0 1"));
+    float value;
+    ASSERT_NE(selective.search(mate, 4, nullptr, &value), nullptr);
+    EXPECT_EQ(value, StaticEvaluator::CHECKMATE_VALUE - 1);
+}
+
+TEST(AlphaBetaTest, Abort)
+{
+    std::shared_ptr<StaticEvaluator> evaluator(new StaticEvaluator);
+    AlphaBeta                        search(evaluator, 2);
+
+    GameState state;
+    state.initialize();
+    std::atomic<bool> abort(true);
+    EXPECT_EQ(search.search(state, 4, &abort), nullptr);
+}
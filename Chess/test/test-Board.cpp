@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "Chess/Board.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/Types.h"
+
+TEST(BoardTest, Occupancy_empty)
+{
+    Board board;
+    EXPECT_EQ(uint64_t(board.occupied()), 0);
+    EXPECT_EQ(uint64_t(board.occupied(Color::WHITE)), 0);
+    EXPECT_EQ(uint64_t(board.occupied(Color::BLACK)), 0);
+}
+
+TEST(BoardTest, Occupancy_initialize)
+{
+    Board board;
+    board.initialize();
+    EXPECT_EQ(uint64_t(board.occupied(Color::BLACK)), 0x000000000000FFFFULL);
+    EXPECT_EQ(uint64_t(board.occupied(Color::WHITE)), 0xFFFF000000000000ULL);
+    EXPECT_EQ(uint64_t(board.occupied()), 0xFFFF00000000FFFFULL);
+    EXPECT_EQ(uint64_t(board.pieces(PieceTypeId::PAWN, Color::BLACK)), 0x000000000000FF00ULL);
+    EXPECT_EQ(uint64_t(board.pieces(PieceTypeId::PAWN, Color::WHITE)), 0x00FF000000000000ULL);
+    EXPECT_EQ(uint64_t(board.pieces(PieceTypeId::KING, Color::BLACK)), 0x0000000000000010ULL);
+    EXPECT_EQ(uint64_t(board.pieces(PieceTypeId::KING, Color::WHITE)), 0x1000000000000000ULL);
+    EXPECT_EQ(uint64_t(board.pieces(PieceTypeId::ROOK, Color::WHITE)), 0x8100000000000000ULL);
+}
+
+TEST(BoardTest, Occupancy_putRemoveMove)
+{
+    Board board;
+    Piece const * whiteQueen = Piece::get(PieceTypeId::QUEEN, Color::WHITE);
+    Piece const * blackKnight = Piece::get(PieceTypeId::KNIGHT, Color::BLACK);
+
+    board.putPiece(whiteQueen, 4, 4);
+    EXPECT_TRUE(board.isOccupied(4, 4));
+    EXPECT_EQ(board.pieceAt(4, 4), whiteQueen);
+    EXPECT_EQ(board.pieces(PieceTypeId::QUEEN, Color::WHITE).test(4, 4), 1);
+
+    board.putPiece(blackKnight, 2, 2);
+    EXPECT_EQ(board.occupied(Color::BLACK).test(2, 2), 1);
+
+    // Capture the knight
+    board.movePiece(Position(4, 4), Position(2, 2));
+    EXPECT_FALSE(board.isOccupied(4, 4));
+    EXPECT_EQ(board.pieceAt(2, 2), whiteQueen);
+    EXPECT_EQ(uint64_t(board.occupied(Color::BLACK)), 0);
+    EXPECT_EQ(uint64_t(board.pieces(PieceTypeId::KNIGHT, Color::BLACK)), 0);
+    EXPECT_EQ(board.pieces(PieceTypeId::QUEEN, Color::WHITE).test(2, 2), 1);
+
+    board.removePiece(2, 2);
+    EXPECT_EQ(uint64_t(board.occupied()), 0);
+    EXPECT_EQ(uint64_t(board.pieces(PieceTypeId::QUEEN, Color::WHITE)), 0);
+}
+
+TEST(BoardTest, SpanIsEmpty)
+{
+    Board board;
+    board.initialize();
+
+    // a1-a8 is blocked by pawns, a3-a6 is not
+    EXPECT_FALSE(board.spanIsEmpty(Position(7, 0), Position(0, 0)));
+    EXPECT_TRUE(board.spanIsEmpty(Position(5, 0), Position(2, 0)));
+
+    // c1-h6 is blocked by the d2 pawn
+    EXPECT_FALSE(board.spanIsEmpty(Position(7, 2), Position(2, 7)));
+
+    board.removePiece(6, 3);
+    EXPECT_TRUE(board.spanIsEmpty(Position(7, 2), Position(2, 7)));
+}
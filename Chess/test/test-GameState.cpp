@@ -0,0 +1,327 @@
+#include "gtest/gtest.h"
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/Types.h"
+
+#include <algorithm>
+
+namespace
+{
+uint64_t mask(int r, int c)
+{
+    return uint64_t(1) << (r * Board::SIZE + c);
+}
+
+bool hasCastle(Piece::MoveList const & moves, Move::Special special)
+{
+    return std::any_of(moves.begin(), moves.end(), [special] (Move const & m) { return m.special() == special; });
+}
+} // anonymous namespace
+
+TEST(GameStateTest, IsAttacked_initial)
+{
+    GameState state;
+    state.initialize();
+
+    // Row 5 (rank 3) is covered by white pawns and knights, row 2 (rank 6) by black
+    for (int c = 0; c < Board::SIZE; ++c)
+    {
+        EXPECT_TRUE(state.isAttacked(Position(5, c), Color::WHITE));
+        EXPECT_FALSE(state.isAttacked(Position(5, c), Color::BLACK));
+        EXPECT_TRUE(state.isAttacked(Position(2, c), Color::BLACK));
+        EXPECT_FALSE(state.isAttacked(Position(2, c), Color::WHITE));
+        EXPECT_FALSE(state.isAttacked(Position(4, c), Color::WHITE));
+        EXPECT_FALSE(state.isAttacked(Position(3, c), Color::BLACK));
+    }
+    EXPECT_FALSE(state.kingIsAttacked(Color::WHITE));
+    EXPECT_FALSE(state.kingIsAttacked(Color::BLACK));
+}
+
+TEST(GameStateTest, AttackersTo)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/2n5/3p4/4P3/8/8/3RK2B w - - 0 1"));
+
+    // d5: attacked by the white pawn on e4 and the rook on d1, but not the bishop on h1 (blocked by e4)
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(3, 3), Color::WHITE)), mask(4, 4) | mask(7, 3));
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(3, 3), Color::BLACK)), 0u);
+
+    // e4: attacked by the black pawn on d5
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(4, 4), Color::BLACK)), mask(3, 3));
+
+    // e5: attacked only by the knight on c6 (pawns don't attack straight ahead)
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(3, 4))), mask(2, 2));
+
+    // d2: attacked by the rook on d1 and the king on e1
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(6, 3))), mask(7, 3) | mask(7, 4));
+}
+
+TEST(GameStateTest, AttackersTo_pawnsOnEdges)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("k7/1P6/8/8/8/8/6p1/7K w - - 0 1"));
+
+    // Pawns attacking the back ranks
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(0, 0), Color::WHITE)), mask(1, 1));
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(0, 2), Color::WHITE)), mask(1, 1));
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(7, 7), Color::BLACK)), mask(6, 6));
+    EXPECT_EQ(uint64_t(state.attackersTo(Position(7, 5), Color::BLACK)), mask(6, 6));
+
+    // Pawns don't attack straight ahead or backward
+    EXPECT_FALSE(state.isAttacked(Position(0, 1), Color::WHITE));
+    EXPECT_FALSE(state.isAttacked(Position(2, 0), Color::WHITE));
+    EXPECT_FALSE(state.isAttacked(Position(7, 6), Color::BLACK));
+    EXPECT_FALSE(state.isAttacked(Position(5, 7), Color::BLACK));
+
+    EXPECT_TRUE(state.inCheck_);
+    EXPECT_TRUE(state.kingIsAttacked(Color::WHITE));
+    EXPECT_TRUE(state.kingIsAttacked(Color::BLACK));
+}
+
+TEST(GameStateTest, AttackInfo)
+{
+    // White king on e1 in check from a knight on d3, with the e2 pawn pinned by a rook on e8 and the c3 bishop
+    // pinned by a bishop on a5
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4r1k1/8/8/b7/8/2Bn4/4P3/4K3 w - - 0 1"));
+
+    GameState::AttackInfo const & info = state.attackInfo();
+    EXPECT_EQ(uint64_t(info.checkers_), mask(5, 3));
+    EXPECT_EQ(uint64_t(info.pinned_), mask(6, 4) | mask(5, 2));
+    EXPECT_EQ(uint64_t(info.pinners_), mask(0, 4) | mask(3, 0));
+    EXPECT_TRUE(state.inCheck_);
+
+    // The attacks of each side are the union of the attacks of each type, and they match the squares attacked
+    for (Color color : { Color::WHITE, Color::BLACK })
+    {
+        uint64_t all = 0;
+        for (int t = 0; t < NUMBER_OF_PIECE_TYPES; ++t)
+            all |= uint64_t(info.byType_[(int)color][t]);
+        EXPECT_EQ(uint64_t(info.bySide_[(int)color]), all);
+        EXPECT_EQ(all, uint64_t(state.attackedSquares(color, state.board_.occupied())));
+    }
+
+    // The king can't retreat along the line of the rook's attack
+    EXPECT_NE(uint64_t(info.kingDanger_) & mask(7, 4), 0);
+
+    // The attacks are recomputed after a move and restored after it is undone
+    Move move(Piece::get(PieceTypeId::KING, Color::WHITE), Position(7, 4), Position(7, 5));
+    GameState::UndoInfo undo;
+    uint64_t white = info.bySide_[(int)Color::WHITE];
+    state.makeMove(move, undo);
+    EXPECT_FALSE(state.inCheck_);
+    EXPECT_TRUE(state.attackInfo().checkers_.empty());
+    EXPECT_NE(uint64_t(state.attackInfo().bySide_[(int)Color::WHITE]), white);
+    state.unmakeMove(move, undo);
+    EXPECT_EQ(uint64_t(state.attackInfo().checkers_), mask(5, 3));
+    EXPECT_EQ(uint64_t(state.attackInfo().bySide_[(int)Color::WHITE]), white);
+}
+
+TEST(GameStateTest, MakeMove_inCheck)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/8/8/8/8/8/R3K3 w - - 0 1"));
+    EXPECT_FALSE(state.inCheck_);
+
+    state.makeMove(Move(Piece::get(PieceTypeId::ROOK, Color::WHITE), Position(7, 0), Position(0, 0)));
+    EXPECT_TRUE(state.inCheck_);
+
+    state.makeMove(Move(Piece::get(PieceTypeId::KING, Color::BLACK), Position(0, 4), Position(1, 4)));
+    EXPECT_FALSE(state.inCheck_);
+}
+
+TEST(GameStateTest, Castle_throughAttackedSquare)
+{
+    Piece const * whiteKing = Piece::get(PieceTypeId::KING, Color::WHITE);
+    Piece::MoveList moves;
+
+    // Nothing attacked: both castles are possible
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen("4k3/8/8/8/8/8/8/R3K2R w KQ - 0 1"));
+        whiteKing->generatePossibleMoves(state, Position(7, 4), moves);
+        EXPECT_TRUE(hasCastle(moves, Move::KINGSIDE_CASTLE));
+        EXPECT_TRUE(hasCastle(moves, Move::QUEENSIDE_CASTLE));
+        EXPECT_EQ(whiteKing->countPossibleMoves(state, Position(7, 4)), (int)moves.size());
+        EXPECT_TRUE(whiteKing->isValidMove(state, Move(Move::KINGSIDE_CASTLE, Color::WHITE)));
+        EXPECT_TRUE(whiteKing->isValidMove(state, Move(Move::QUEENSIDE_CASTLE, Color::WHITE)));
+    }
+
+    // The rook on f8 attacks f1, so the king can't castle king-side
+    {
+        moves.clear();
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen("4kr2/8/8/8/8/8/8/R3K2R w KQ - 0 1"));
+        whiteKing->generatePossibleMoves(state, Position(7, 4), moves);
+        EXPECT_FALSE(hasCastle(moves, Move::KINGSIDE_CASTLE));
+        EXPECT_TRUE(hasCastle(moves, Move::QUEENSIDE_CASTLE));
+        EXPECT_FALSE(whiteKing->isValidMove(state, Move(Move::KINGSIDE_CASTLE, Color::WHITE)));
+    }
+
+    // The rook on b8 attacks b1, which must be empty but the king doesn't pass through
+    {
+        moves.clear();
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen("1r2k3/8/8/8/8/8/8/R3K2R w KQ - 0 1"));
+        whiteKing->generatePossibleMoves(state, Position(7, 4), moves);
+        EXPECT_TRUE(hasCastle(moves, Move::KINGSIDE_CASTLE));
+        EXPECT_TRUE(hasCastle(moves, Move::QUEENSIDE_CASTLE));
+    }
+
+    // The bishop on h6 attacks c1, so the king can't castle queen-side
+    {
+        moves.clear();
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen("4k3/8/7b/8/8/8/8/R3K2R w KQ - 0 1"));
+        whiteKing->generatePossibleMoves(state, Position(7, 4), moves);
+        EXPECT_TRUE(hasCastle(moves, Move::KINGSIDE_CASTLE));
+        EXPECT_FALSE(hasCastle(moves, Move::QUEENSIDE_CASTLE));
+        EXPECT_FALSE(whiteKing->isValidMove(state, Move(Move::QUEENSIDE_CASTLE, Color::WHITE)));
+    }
+}
+
+namespace
+{
+// Returns all the moves for the player whose turn it is
+Piece::MoveList allMoves(GameState const & state)
+{
+    Piece::MoveList moves;
+    for (int r = 0; r < Board::SIZE; ++r)
+    {
+        for (int c = 0; c < Board::SIZE; ++c)
+        {
+            Piece const * piece = state.board_.pieceAt(r, c);
+            if (piece && piece->color() == state.whoseTurn_)
+                piece->generatePossibleMoves(state, Position(r, c), moves);
+        }
+    }
+    return moves;
+}
+
+// Makes and unmakes every move to the given depth, checking that the hash matches one computed from scratch and that
+// the state is restored
+void checkMakeUnmake(GameState & state, int depth)
+{
+    std::string fen  = state.fen();
+    ZHash       hash = state.zhash();
+
+    for (auto const & move : allMoves(state))
+    {
+        GameState::UndoInfo undo;
+        state.makeMove(move, undo);
+
+        GameState fromScratch;
+        ASSERT_TRUE(fromScratch.initializeFromFen(state.fen().c_str())) << state.fen();
+        EXPECT_EQ(state.zhash(), fromScratch.zhash()) << fen << " " << move.notation();
+        EXPECT_EQ(state.inCheck_, fromScratch.inCheck_) << fen << " " << move.notation();
+
+        if (depth > 1)
+            checkMakeUnmake(state, depth - 1);
+
+        state.unmakeMove(move, undo);
+        EXPECT_EQ(state.fen(), fen) << move.notation();
+        EXPECT_EQ(state.zhash(), hash) << fen << " " << move.notation();
+    }
+}
+} // anonymous namespace
+
+TEST(GameStateTest, MakeUnmake)
+{
+    static char const * const FENS[] =
+    {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/8/8/3pP3/8/8/8/R3K2R w KQkq d6 0 1",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+    };
+
+    for (auto fen : FENS)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(fen)) << fen;
+        checkMakeUnmake(state, 2);
+    }
+}
+
+TEST(GameStateTest, MakeUnmake_enPassant)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/3p4/8/4P3/8/8/8/4K3 b - - 0 1"));
+    std::string fen0 = state.fen();
+
+    // d7-d5 allows e5xd6 en passant
+    GameState::UndoInfo undo1;
+    Move push(Piece::get(PieceTypeId::PAWN, Color::BLACK), Position(1, 3), Position(3, 3));
+    state.makeMove(push, undo1);
+    EXPECT_EQ(state.enPassant_, Position(2, 3));
+    EXPECT_EQ(state.fiftyMoveTimer_, 0);
+    std::string fen1 = state.fen();
+
+    GameState::UndoInfo undo2;
+    Move capture = Move::enPassant(Color::WHITE, Position(3, 4), Position(2, 3));
+    state.makeMove(capture, undo2);
+    EXPECT_EQ(state.board_.pieceAt(3, 3), NO_PIECE);
+    EXPECT_EQ(state.board_.pieceAt(2, 3), Piece::get(PieceTypeId::PAWN, Color::WHITE));
+    EXPECT_FALSE(state.enPassant_.isValid());
+
+    state.unmakeMove(capture, undo2);
+    EXPECT_EQ(state.fen(), fen1);
+    EXPECT_EQ(state.board_.pieceAt(3, 3), Piece::get(PieceTypeId::PAWN, Color::BLACK));
+
+    state.unmakeMove(push, undo1);
+    EXPECT_EQ(state.fen(), fen0);
+}
+
+TEST(GameStateTest, MakeUnmake_castleStatus)
+{
+    // The rook on a1 captures the rook on a8, so both queen-side castles become unavailable
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 5 10"));
+    std::string fen = state.fen();
+    ZHash       hash = state.zhash();
+
+    GameState::UndoInfo undo;
+    Move capture(Piece::get(PieceTypeId::ROOK, Color::WHITE), Position(7, 0), Position(0, 0), true);
+    state.makeMove(capture, undo);
+    EXPECT_FALSE(state.queenSideCastleIsAllowed(Color::WHITE));
+    EXPECT_FALSE(state.queenSideCastleIsAllowed(Color::BLACK));
+    EXPECT_TRUE(state.kingSideCastleIsAllowed(Color::WHITE));
+    EXPECT_TRUE(state.kingSideCastleIsAllowed(Color::BLACK));
+    EXPECT_EQ(state.fiftyMoveTimer_, 0);
+
+    state.unmakeMove(capture, undo);
+    EXPECT_EQ(state.fen(), fen);
+    EXPECT_EQ(state.zhash(), hash);
+    EXPECT_EQ(state.board_.pieceAt(0, 0), Piece::get(PieceTypeId::ROOK, Color::BLACK));
+}
+
+TEST(GameStateTest, NullMove)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3"));
+    state.makeNullMove();
+    EXPECT_EQ(state.whoseTurn_, Color::BLACK);
+    EXPECT_FALSE(state.enPassant_.isValid());
+    EXPECT_FALSE(state.inCheck_);
+
+    GameState fromScratch;
+    ASSERT_TRUE(fromScratch.initializeFromFen(state.fen().c_str())) << state.fen();
+    EXPECT_EQ(state.zhash(), fromScratch.zhash());
+    EXPECT_EQ(state.fen(), fromScratch.fen());
+
+    // Undoing the null move restores the state
+    GameState before;
+    ASSERT_TRUE(before.initializeFromFen("rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3"));
+    GameState           after(before);
+    GameState::UndoInfo undo;
+    after.makeNullMove(undo);
+    EXPECT_EQ(after.zhash(), state.zhash());
+    after.unmakeNullMove(undo);
+    EXPECT_EQ(after.fen(), before.fen());
+    EXPECT_EQ(after.zhash(), before.zhash());
+    EXPECT_EQ(after.move_, before.move_);
+    EXPECT_TRUE(after == before);
+}
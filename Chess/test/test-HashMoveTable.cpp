@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "Chess/GameState.h"
+#include "Chess/HashMoveTable.h"
+#include "Chess/Move.h"
+#include "Chess/MoveGenerator.h"
+#include "Chess/MoveList.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(HashMoveTableTest, StoreAndProbe)
+{
+    GameState state;
+    state.initialize();
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(state, moves);
+    ASSERT_GE(moves.size(), 2u);
+
+    HashMoveTable table(1000);
+    EXPECT_EQ(table.size(), 512u);
+
+    Move move;
+    EXPECT_FALSE(table.probe(state.fingerprint(), state.board_, move));
+
+    table.store(state.fingerprint(), moves[0], 3);
+    ASSERT_TRUE(table.probe(state.fingerprint(), state.board_, move));
+    EXPECT_EQ(move, moves[0]);
+
+    // A shallower search doesn't replace the move, but a search that is at least as deep does
+    table.store(state.fingerprint(), moves[1], 2);
+    ASSERT_TRUE(table.probe(state.fingerprint(), state.board_, move));
+    EXPECT_EQ(move, moves[0]);
+    table.store(state.fingerprint(), moves[1], 3);
+    ASSERT_TRUE(table.probe(state.fingerprint(), state.board_, move));
+    EXPECT_EQ(move, moves[1]);
+
+    // A different position with the same index doesn't match
+    EXPECT_FALSE(table.probe(state.fingerprint() ^ table.size(), state.board_, move));
+
+    table.clear();
+    EXPECT_FALSE(table.probe(state.fingerprint(), state.board_, move));
+}
+
+TEST(HashMoveTableTest, Threads)
+{
+    GameState state;
+    state.initialize();
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(state, moves);
+
+    // The move and depth stored for a key are functions of the key, so a probe that returns anything else found an
+    // entry that was torn by simultaneous writes
+    std::mt19937_64       random(1);
+    std::vector<uint64_t> keys(1000);
+    for (auto & key : keys)
+        key = random();
+    auto moveOf  = [&moves] (uint64_t key) { return moves[key % moves.size()]; };
+    auto depthOf = [] (uint64_t key) { return int(key >> 60) + 1; };
+
+    // The table is much smaller than the number of keys, so the threads are constantly replacing each other's entries
+    HashMoveTable            table(64);
+    std::atomic<int>         mismatches(0);
+    std::atomic<int>         hits(0);
+    std::vector<std::thread> threads;
+    for (unsigned id = 0; id < 8; ++id)
+    {
+        threads.emplace_back([&, id] {
+            std::mt19937 pick(id);
+            for (int i = 0; i < 200000; ++i)
+            {
+                uint64_t key = keys[pick() % keys.size()];
+                if (i & 1)
+                {
+                    table.store(key, moveOf(key), depthOf(key));
+                }
+                else
+                {
+                    Move move;
+                    if (table.probe(key, state.board_, move))
+                    {
+                        ++hits;
+                        if (move != moveOf(key))
+                            ++mismatches;
+                    }
+                }
+            }
+        });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    EXPECT_GT(hits, 0);
+    EXPECT_EQ(mismatches, 0);
+}
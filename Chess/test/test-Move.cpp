@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "Chess/Board.h"
+#include "Chess/Move.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/Types.h"
+
+TEST(MoveTest, Size)
+{
+    EXPECT_EQ(sizeof(Move), 4u);
+    EXPECT_EQ(sizeof(Move::Packed), 2u);
+}
+
+TEST(MoveTest, Normal)
+{
+    Piece const * whiteKnight = Piece::get(PieceTypeId::KNIGHT, Color::WHITE);
+    Piece const * blackBishop = Piece::get(PieceTypeId::BISHOP, Color::BLACK);
+
+    Move quiet(whiteKnight, Position(7, 1), Position(5, 2));
+    EXPECT_EQ(quiet.piece(), whiteKnight);
+    EXPECT_EQ(quiet.movedType(), PieceTypeId::KNIGHT);
+    EXPECT_EQ(quiet.color(), Color::WHITE);
+    EXPECT_EQ(quiet.from(), Position(7, 1));
+    EXPECT_EQ(quiet.to(), Position(5, 2));
+    EXPECT_EQ(quiet.special(), Move::NORMAL);
+    EXPECT_FALSE(quiet.isSpecial());
+    EXPECT_FALSE(quiet.isCapture());
+    EXPECT_EQ(quiet.capturedType(), PieceTypeId::INVALID);
+    EXPECT_EQ(quiet.promotedTo(), PieceTypeId::INVALID);
+
+    Move capture(blackBishop, Position(0, 0), Position(7, 7), whiteKnight);
+    EXPECT_EQ(capture.piece(), blackBishop);
+    EXPECT_EQ(capture.color(), Color::BLACK);
+    EXPECT_EQ(capture.from(), Position(0, 0));
+    EXPECT_EQ(capture.to(), Position(7, 7));
+    EXPECT_TRUE(capture.isCapture());
+    EXPECT_EQ(capture.capturedType(), PieceTypeId::KNIGHT);
+
+    EXPECT_TRUE(quiet == Move(whiteKnight, Position(7, 1), Position(5, 2), NO_PIECE));
+    EXPECT_TRUE(quiet != capture);
+}
+
+TEST(MoveTest, Special)
+{
+    Move ks = Move::kingSideCastle(Color::BLACK);
+    EXPECT_TRUE(ks.isKingSideCastle());
+    EXPECT_TRUE(ks.isSpecial());
+    EXPECT_EQ(ks.special(), Move::KINGSIDE_CASTLE);
+    EXPECT_EQ(ks.piece(), Piece::get(PieceTypeId::KING, Color::BLACK));
+    EXPECT_EQ(ks.from(), Position(0, 4));
+    EXPECT_EQ(ks.to(), Position(0, 6));
+
+    Move qs = Move::queenSideCastle(Color::WHITE);
+    EXPECT_TRUE(qs.isQueenSideCastle());
+    EXPECT_EQ(qs.from(), Position(7, 4));
+    EXPECT_EQ(qs.to(), Position(7, 2));
+
+    Move ep = Move::enPassant(Color::WHITE, Position(3, 4), Position(2, 3));
+    EXPECT_TRUE(ep.isEnPassant());
+    EXPECT_TRUE(ep.isCapture());
+    EXPECT_EQ(ep.movedType(), PieceTypeId::PAWN);
+    EXPECT_EQ(ep.capturedType(), PieceTypeId::PAWN);
+
+    Move promotion = Move::promotion(Color::BLACK, Position(6, 0), Position(7, 1), true, PieceTypeId::KNIGHT);
+    EXPECT_TRUE(promotion.isPromotion());
+    EXPECT_TRUE(promotion.isCapture());
+    EXPECT_EQ(promotion.special(), Move::PROMOTION);
+    EXPECT_EQ(promotion.promotedTo(), PieceTypeId::KNIGHT);
+    EXPECT_EQ(promotion.color(), Color::BLACK);
+    EXPECT_EQ(Move::promotion(Color::WHITE, Position(1, 0), Position(0, 0)).promotedTo(), PieceTypeId::QUEEN);
+    EXPECT_FALSE(Move::promotion(Color::WHITE, Position(1, 0), Position(0, 0)).isCapture());
+
+    Move resign = Move::resign(Color::BLACK);
+    EXPECT_TRUE(resign.isResignation());
+    EXPECT_EQ(resign.color(), Color::BLACK);
+    EXPECT_FALSE(Board::isValidPosition(resign.from()));
+    EXPECT_TRUE(Move::undo().isUndo());
+    EXPECT_TRUE(Move::reset().isStartingPosition());
+}
+
+TEST(MoveTest, Packed)
+{
+    Board board;
+    board.initialize();
+
+    Move knight(Piece::get(PieceTypeId::KNIGHT, Color::WHITE), Position(7, 6), Position(5, 5));
+    EXPECT_EQ(Move::unpack(knight.packed(), board), knight);
+
+    // The piece types come from the board
+    board.putPiece(Piece::get(PieceTypeId::ROOK, Color::BLACK), Position(4, 4));
+    board.putPiece(Piece::get(PieceTypeId::QUEEN, Color::WHITE), Position(4, 0));
+    Move capture(Piece::get(PieceTypeId::QUEEN, Color::WHITE), Position(4, 0), Position(4, 4), board.pieceAt(4, 4));
+    Move unpacked = Move::unpack(capture.packed(), board);
+    EXPECT_EQ(unpacked, capture);
+    EXPECT_EQ(unpacked.capturedType(), PieceTypeId::ROOK);
+
+    Move castle = Move::kingSideCastle(Color::WHITE);
+    EXPECT_EQ(Move::unpack(castle.packed(), board), castle);
+
+    Move promotion = Move::promotion(Color::BLACK, Position(6, 0), Position(7, 0), false, PieceTypeId::ROOK);
+    board.putPiece(Piece::get(PieceTypeId::PAWN, Color::BLACK), Position(6, 0));
+    EXPECT_EQ(Move::unpack(promotion.packed(), board).promotedTo(), PieceTypeId::ROOK);
+
+    // A capture-promotion includes the type of the captured piece, as the unpacked move does
+    board.putPiece(Piece::get(PieceTypeId::KNIGHT, Color::WHITE), Position(7, 1));
+    Move capturePromotion =
+        Move::promotion(Color::BLACK, Position(6, 0), Position(7, 1), true, PieceTypeId::QUEEN, PieceTypeId::KNIGHT);
+    unpacked = Move::unpack(capturePromotion.packed(), board);
+    EXPECT_EQ(unpacked, capturePromotion);
+    EXPECT_EQ(unpacked.capturedType(), PieceTypeId::KNIGHT);
+}
+
+TEST(MoveTest, Notation)
+{
+    Move knight(Piece::get(PieceTypeId::KNIGHT, Color::WHITE), Position(7, 6), Position(5, 5));
+    EXPECT_EQ(knight.notation(Notation::STANDARD), "Nf3");
+    EXPECT_EQ(knight.notation(Notation::LONG), "Ng1-f3");
+
+    Move promotion = Move::promotion(Color::WHITE, Position(1, 0), Position(0, 0), false, PieceTypeId::KNIGHT);
+    EXPECT_EQ(promotion.notation(Notation::STANDARD), "a8N");
+    EXPECT_EQ(promotion.notation(Notation::PGN), "a7-a8=N");
+
+    EXPECT_EQ(Move::kingSideCastle(Color::WHITE).notation(Notation::PGN), "O-O");
+    EXPECT_EQ(Move::resign(Color::BLACK).notation(Notation::STANDARD), "0-1");
+}
@@ -0,0 +1,242 @@
+#include "gtest/gtest.h"
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/MoveGenerator.h"
+#include "Chess/MoveList.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/Types.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+// Well-known positions and their perft results, from https://www.chessprogramming.org/Perft_Results
+struct PerftCase
+{
+    char const * fen;
+    int          depth;
+    uint64_t     nodes;
+};
+
+PerftCase const PERFT_CASES[] =
+{
+    { "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",                 3, 8902 },
+    { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",     2, 2039 },
+    { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",                                3, 2812 },
+    { "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",         2, 264  },
+    { "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",                2, 1486 },
+    { "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 2, 2079 },
+};
+
+uint64_t perft(GameState & state, int depth)
+{
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(state, moves);
+    if (depth == 1)
+        return moves.size();
+
+    uint64_t nodes = 0;
+    for (auto const & move : moves)
+    {
+        GameState::UndoInfo undo;
+        state.makeMove(move, undo);
+        nodes += perft(state, depth - 1);
+        state.unmakeMove(move, undo);
+    }
+    return nodes;
+}
+
+// Returns the pseudo-legal moves that don't leave the king in check
+MoveList filteredPossibleMoves(GameState & state)
+{
+    MoveList possible;
+    for (int r = 0; r < Board::SIZE; ++r)
+    {
+        for (int c = 0; c < Board::SIZE; ++c)
+        {
+            Piece const * piece = state.board_.pieceAt(r, c);
+            if (piece && piece->color() == state.whoseTurn_)
+                piece->generatePossibleMoves(state, Position(r, c), possible);
+        }
+    }
+
+    MoveList legal;
+    Color    us = state.whoseTurn_;
+    for (auto const & move : possible)
+    {
+        GameState::UndoInfo undo;
+        state.makeMove(move, undo);
+        if (!state.kingIsAttacked(us))
+            legal.push_back(move);
+        state.unmakeMove(move, undo);
+    }
+    return legal;
+}
+
+bool contains(MoveList const & moves, Move const & move)
+{
+    return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+} // anonymous namespace
+
+TEST(MoveGeneratorTest, Perft)
+{
+    for (auto const & p : PERFT_CASES)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(p.fen)) << p.fen;
+        EXPECT_EQ(perft(state, p.depth), p.nodes) << p.fen;
+    }
+}
+
+TEST(MoveGeneratorTest, MatchesFilteredPossibleMoves)
+{
+    for (auto const & p : PERFT_CASES)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(p.fen)) << p.fen;
+
+        MoveList legal;
+        MoveGenerator::generateLegalMoves(state, legal);
+        MoveList expected = filteredPossibleMoves(state);
+
+        EXPECT_EQ(legal.size(), expected.size()) << p.fen;
+        for (auto const & move : expected)
+            EXPECT_TRUE(contains(legal, move)) << p.fen << " " << move.notation(Notation::LONG);
+    }
+}
+
+TEST(MoveGeneratorTest, Evasions)
+{
+    // Double check: only the king can move
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen("4k3/8/8/8/1b6/8/8/R3K2r w Q - 0 1"));
+        MoveList moves;
+        MoveGenerator::generateLegalMoves(state, moves);
+        EXPECT_TRUE(state.inCheck_);
+        for (auto const & move : moves)
+            EXPECT_EQ(move.movedType(), PieceTypeId::KING) << move.notation(Notation::LONG);
+    }
+
+    // Single check by a rook: block, capture, or move the king. Castling is not allowed.
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen("4k3/8/8/8/8/3B4/8/R3K2r w Q - 0 1"));
+        MoveList moves;
+        MoveGenerator::generateLegalMoves(state, moves);
+        EXPECT_TRUE(state.inCheck_);
+        EXPECT_TRUE(contains(moves, Move(Piece::get(PieceTypeId::BISHOP, Color::WHITE), Position(5, 3), Position(7, 5), NO_PIECE)));
+        for (auto const & move : moves)
+        {
+            EXPECT_FALSE(move.isQueenSideCastle());
+            if (move.movedType() == PieceTypeId::ROOK)
+                ADD_FAILURE() << "The rook can't resolve the check: " << move.notation(Notation::LONG);
+        }
+    }
+
+    // Checkmate: no moves
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen("R5k1/5ppp/8/8/8/8/8/4K3 b - - 0 1"));
+        MoveList moves;
+        MoveGenerator::generateLegalMoves(state, moves);
+        EXPECT_TRUE(state.inCheck_);
+        EXPECT_TRUE(moves.empty());
+    }
+}
+
+TEST(MoveGeneratorTest, Pins)
+{
+    // The knight on d2 is pinned by the bishop on a5 and can't move. The rook on e2 is pinned by the rook on e8 and can
+    // only move along the e file.
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4r1k1/8/8/b7/8/8/3NR3/4K3 w - - 0 1"));
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(state, moves);
+    for (auto const & move : moves)
+    {
+        EXPECT_NE(move.movedType(), PieceTypeId::KNIGHT) << move.notation(Notation::LONG);
+        if (move.movedType() == PieceTypeId::ROOK)
+        {
+            EXPECT_EQ(move.to().column, 4) << move.notation(Notation::LONG);
+        }
+    }
+
+    // En passant would expose the king along the row
+    GameState ep;
+    ASSERT_TRUE(ep.initializeFromFen("8/8/8/KPp4r/8/8/8/4k3 w - c6 0 1"));
+    moves.clear();
+    MoveGenerator::generateLegalMoves(ep, moves);
+    for (auto const & move : moves)
+        EXPECT_FALSE(move.isEnPassant());
+}
+
+TEST(MoveGeneratorTest, CapturesAndQuiets)
+{
+    for (auto const & p : PERFT_CASES)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(p.fen)) << p.fen;
+
+        MoveList all;
+        MoveList captures;
+        MoveList quiets;
+        MoveGenerator::generateLegalMoves(state, all);
+        MoveGenerator::generateLegalMoves(state, captures, MoveGenerator::CAPTURES);
+        MoveGenerator::generateLegalMoves(state, quiets, MoveGenerator::QUIETS);
+
+        EXPECT_EQ(captures.size() + quiets.size(), all.size()) << p.fen;
+        for (auto const & move : captures)
+            EXPECT_TRUE(move.isCapture() || move.isPromotion()) << p.fen << " " << move.notation(Notation::LONG);
+        for (auto const & move : quiets)
+        {
+            EXPECT_FALSE(move.isCapture() || move.isPromotion()) << p.fen << " " << move.notation(Notation::LONG);
+            EXPECT_TRUE(contains(all, move)) << p.fen << " " << move.notation(Notation::LONG);
+        }
+    }
+}
+
+TEST(MoveGeneratorTest, IsLegal)
+{
+    for (auto const & p : PERFT_CASES)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(p.fen)) << p.fen;
+
+        MoveList legal;
+        MoveGenerator::generateLegalMoves(state, legal);
+        for (auto const & move : legal)
+            EXPECT_TRUE(MoveGenerator::isLegal(state, move)) << p.fen << " " << move.notation(Notation::LONG);
+    }
+
+    // Moves that are not legal in the position
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4r1k1/8/8/b7/8/8/3NR3/4K3 w - - 0 1"));
+    Piece const * knight = Piece::get(PieceTypeId::KNIGHT, Color::WHITE);
+    Piece const * rook   = Piece::get(PieceTypeId::ROOK, Color::WHITE);
+    EXPECT_FALSE(MoveGenerator::isLegal(state, Move(knight, Position(6, 3), Position(4, 2), NO_PIECE)));  // Pinned
+    EXPECT_FALSE(MoveGenerator::isLegal(state, Move(rook, Position(6, 4), Position(6, 7), NO_PIECE)));    // Pinned
+    EXPECT_TRUE(MoveGenerator::isLegal(state, Move(rook, Position(6, 4), Position(3, 4), NO_PIECE)));
+    EXPECT_FALSE(MoveGenerator::isLegal(state, Move(rook, Position(5, 4), Position(3, 4), NO_PIECE)));    // No piece
+    EXPECT_FALSE(MoveGenerator::isLegal(state, Move::kingSideCastle(Color::WHITE)));
+    EXPECT_FALSE(MoveGenerator::isLegal(state, Move::resign(Color::WHITE)));
+
+    // Promotions are still legal after a round trip through the compact form, which gets the captured piece from the
+    // board
+    GameState promotion;
+    ASSERT_TRUE(promotion.initializeFromFen("r6k/1P6/8/8/8/8/8/7K w - - 0 1"));
+    MoveList promotions;
+    MoveGenerator::generateLegalMoves(promotion, promotions, MoveGenerator::CAPTURES);
+    ASSERT_EQ(promotions.size(), 8u);
+    for (auto const & move : promotions)
+    {
+        Move unpacked = Move::unpack(move.packed(), promotion.board_);
+        EXPECT_EQ(unpacked, move) << move.notation(Notation::LONG);
+        EXPECT_TRUE(MoveGenerator::isLegal(promotion, unpacked)) << move.notation(Notation::LONG);
+        if (move.isCapture())
+            EXPECT_EQ(move.capturedType(), PieceTypeId::ROOK) << move.notation(Notation::LONG);
+    }
+}
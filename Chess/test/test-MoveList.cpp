@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+#include "Chess/Move.h"
+#include "Chess/MoveList.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/Types.h"
+
+TEST(MoveListTest, Empty)
+{
+    MoveList moves;
+    EXPECT_TRUE(moves.empty());
+    EXPECT_EQ(moves.size(), 0u);
+    EXPECT_EQ(moves.begin(), moves.end());
+    EXPECT_GE(MoveList::capacity(), 218u);
+}
+
+TEST(MoveListTest, PushIterateClear)
+{
+    Piece const * rook = Piece::get(PieceTypeId::ROOK, Color::WHITE);
+    MoveList      moves;
+
+    for (int c = 1; c < 8; ++c)
+        moves.emplace_back(rook, Position(7, 0), Position(7, c), NO_PIECE);
+    moves.push_back(Move::kingSideCastle(Color::WHITE));
+
+    EXPECT_FALSE(moves.empty());
+    EXPECT_EQ(moves.size(), 8u);
+    EXPECT_EQ(moves[0].to(), Position(7, 1));
+    EXPECT_TRUE(moves.back().isKingSideCastle());
+
+    int c = 1;
+    for (auto const & m : moves)
+    {
+        if (m.isKingSideCastle())
+            break;
+        EXPECT_EQ(m.to(), Position(7, c));
+        ++c;
+    }
+    EXPECT_EQ(c, 8);
+
+    moves.pop_back();
+    EXPECT_EQ(moves.size(), 7u);
+
+    moves.clear();
+    EXPECT_TRUE(moves.empty());
+}
+
+TEST(MoveListTest, Capacity)
+{
+    Piece const * queen = Piece::get(PieceTypeId::QUEEN, Color::BLACK);
+    MoveList      moves;
+    for (size_t i = 0; i < MoveList::capacity(); ++i)
+        moves.emplace_back(queen, Position(0, 0), Position(int(i / 8) % 8, int(i % 8)), NO_PIECE);
+    EXPECT_EQ(moves.size(), MoveList::capacity());
+}
@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/MoveOrdering.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/ResponseGenerator.h"
+#include "Chess/Types.h"
+
+namespace
+{
+Move quiet(PieceTypeId type, Color color, Position from, Position to)
+{
+    return Move(Piece::get(type, color), from, to);
+}
+} // anonymous namespace
+
+TEST(MoveOrderingTest, Priorities)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/8/3p4/8/2N5/8/4K1N1 w - - 0 1"));
+
+    MoveOrdering ordering;
+    Move         capture(Piece::get(PieceTypeId::KNIGHT, Color::WHITE), Position(5, 2), Position(3, 3), true);
+    Move         killer  = quiet(PieceTypeId::KNIGHT, Color::WHITE, Position(7, 6), Position(5, 5));
+    Move         counter = quiet(PieceTypeId::KING, Color::WHITE, Position(7, 4), Position(6, 4));
+    Move         other   = quiet(PieceTypeId::KNIGHT, Color::WHITE, Position(5, 2), Position(4, 0));
+
+    // Without any cutoffs, only the capture is prioritized
+    EXPECT_GT(MoveOrdering::priority(&ordering, state, capture, 1), 0);
+    EXPECT_EQ(MoveOrdering::priority(&ordering, state, killer, 1), 0);
+    EXPECT_EQ(MoveOrdering::priority(nullptr, state, killer, 1), 0);
+
+    // A cutoff in a sibling makes a killer, and the history of the killer is also recorded
+    GameState sibling(state);
+    sibling.move_ = quiet(PieceTypeId::KING, Color::BLACK, Position(0, 3), Position(0, 4));
+    ordering.recordCutoff(sibling, killer, 2, 1);
+    ordering.recordCutoff(sibling, other, 1, 6);
+
+    // A cutoff after the same previous move makes a countermove
+    GameState cousin(state);
+    cousin.move_ = quiet(PieceTypeId::PAWN, Color::BLACK, Position(2, 3), Position(3, 3));
+    ordering.recordCutoff(cousin, counter, 1, 5);
+    state.move_ = cousin.move_;
+
+    int capturePriority = MoveOrdering::priority(&ordering, state, capture, 1);
+    int killerPriority  = MoveOrdering::priority(&ordering, state, killer, 1);
+    int counterPriority = MoveOrdering::priority(&ordering, state, counter, 1);
+    int otherPriority   = MoveOrdering::priority(&ordering, state, other, 1);
+    EXPECT_GT(capturePriority, killerPriority);
+    EXPECT_GT(killerPriority, counterPriority);
+    EXPECT_EQ(counterPriority, MoveOrdering::COUNTERMOVE_PRIORITY);
+    EXPECT_GT(counterPriority, otherPriority);
+    EXPECT_EQ(otherPriority, ordering.history(other));
+    EXPECT_GT(otherPriority, 0);
+
+    // Aging halves the history
+    ordering.age();
+    EXPECT_EQ(ordering.history(killer), 2);
+}
+
+TEST(MoveOrderingTest, ResponseGenerator)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/8/3p4/8/2N5/8/4K1N1 w - - 0 1"));
+
+    // Without an ordering, the capture still comes first and the quiet moves follow
+    ResponseGenerator                    generate;
+    std::vector<GamePlayer::GameState *> responses = generate(state, 1);
+    ASSERT_FALSE(responses.empty());
+    EXPECT_TRUE(static_cast<GameState *>(responses[0])->move_.isCapture());
+    for (size_t i = 1; i < responses.size(); ++i)
+    {
+        EXPECT_FALSE(static_cast<GameState *>(responses[i])->move_.isCapture());
+    }
+    for (auto response : responses)
+    {
+        delete response;
+    }
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "Chess/Board.h"
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/MoveList.h"
+#include "Chess/Piece.h"
+#include "Chess/PieceMoves.h"
+#include "Chess/Position.h"
+#include "Chess/Types.h"
+
+#include <algorithm>
+
+namespace
+{
+char const * const FENS[] =
+{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+
+bool contains(MoveList const & moves, Move const & move)
+{
+    return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+} // anonymous namespace
+
+TEST(PieceMovesTest, MatchesVirtualGenerators)
+{
+    for (auto fen : FENS)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(fen)) << fen;
+
+        MoveList expected;
+        for (int r = 0; r < Board::SIZE; ++r)
+        {
+            for (int c = 0; c < Board::SIZE; ++c)
+            {
+                Piece const * piece = state.board_.pieceAt(r, c);
+                if (piece && piece->color() == state.whoseTurn_)
+                    piece->generatePossibleMoves(state, Position(r, c), expected);
+            }
+        }
+
+        MoveList moves;
+        PieceMoves::generatePossibleMoves(state, moves);
+        EXPECT_EQ(moves.size(), expected.size()) << fen;
+        for (auto const & move : expected)
+            EXPECT_TRUE(contains(moves, move)) << fen << " " << move.notation(Notation::LONG);
+    }
+}
+
+TEST(PieceMovesTest, CapturesAreTheCapturesAndPromotionsOfAllMoves)
+{
+    for (auto fen : FENS)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(fen)) << fen;
+
+        MoveList all;
+        PieceMoves::generatePossibleMoves(state, all);
+        MoveList expected;
+        for (auto const & move : all)
+        {
+            if (move.isCapture() || move.isPromotion())
+                expected.push_back(move);
+        }
+
+        MoveList captures;
+        PieceMoves::generatePossibleCaptures(state, captures);
+        EXPECT_EQ(captures.size(), expected.size()) << fen;
+        for (auto const & move : expected)
+            EXPECT_TRUE(contains(captures, move)) << fen << " " << move.notation(Notation::LONG);
+    }
+}
+
+TEST(PieceMovesTest, CountsAndThreats)
+{
+    // A rook on d4 with a friendly piece on d6 and an enemy piece on f4
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/3P4/8/3R1p2/8/8/4K3 w - - 0 1"));
+    Position from(4, 3);
+
+    MoveList moves;
+    PieceMoves::generate<PieceTypeId::ROOK>(state.board_, Piece::get(PieceTypeId::ROOK, Color::WHITE), from, moves);
+    EXPECT_EQ(moves.size(), 9u);
+    EXPECT_EQ(PieceMoves::count<PieceTypeId::ROOK>(state.board_, Color::WHITE, from), 9);
+    EXPECT_EQ(PieceMoves::countThreats<PieceTypeId::ROOK>(state.board_, from), 2);
+
+    // A knight in the corner
+    Position corner(7, 0);
+    EXPECT_EQ(PieceMoves::count<PieceTypeId::KNIGHT>(state.board_, Color::WHITE, corner), 2);
+    EXPECT_EQ(PieceMoves::countThreats<PieceTypeId::KNIGHT>(state.board_, corner), 0);
+}
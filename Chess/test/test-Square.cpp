@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "Chess/Position.h"
+#include "Chess/Square.h"
+
+TEST(SquareTest, Constructors)
+{
+    Square invalid;
+    EXPECT_FALSE(invalid.isValid());
+
+    Square a8(0, 0);
+    EXPECT_TRUE(a8.isValid());
+    EXPECT_EQ(a8.index(), 0);
+
+    Square h1(7, 7);
+    EXPECT_EQ(h1.index(), 63);
+    EXPECT_EQ(h1.row(), 7);
+    EXPECT_EQ(h1.column(), 7);
+
+    Square e4(36);
+    EXPECT_EQ(e4.row(), 4);
+    EXPECT_EQ(e4.column(), 4);
+    EXPECT_EQ(e4.notation(), "e4");
+    EXPECT_EQ(invalid.notation(), "-");
+}
+
+TEST(SquareTest, Position)
+{
+    for (int r = 0; r < 8; ++r)
+    {
+        for (int c = 0; c < 8; ++c)
+        {
+            Position p(r, c);
+            Square   s(p);
+            EXPECT_TRUE(s.isValid());
+            EXPECT_EQ(s, Square(r, c));
+            EXPECT_EQ(s.position(), p);
+        }
+    }
+
+    EXPECT_FALSE(Square(Position()).isValid());
+    EXPECT_FALSE(Square(Position(8, 0)).isValid());
+    EXPECT_FALSE(Square(Position(0, -1)).isValid());
+    EXPECT_EQ(Square().position(), Position());
+}
+
+TEST(SquareTest, FlipAndMirror)
+{
+    Square e2(6, 4);
+    EXPECT_EQ(e2.flipped(), Square(1, 4));
+    EXPECT_EQ(e2.flipped().flipped(), e2);
+    EXPECT_EQ(e2.mirrored(), Square(6, 3));
+    EXPECT_EQ(e2.mirrored().mirrored(), e2);
+
+    static_assert(Square(0, 0).flipped() == Square(7, 0), "flipped() is constexpr");
+    static_assert(sizeof(Square) == 1, "Square is one byte");
+}
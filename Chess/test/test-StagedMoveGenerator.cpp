@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/MoveGenerator.h"
+#include "Chess/MoveList.h"
+#include "Chess/MoveOrdering.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/StagedMoveGenerator.h"
+#include "Chess/Types.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace
+{
+char const * const FENS[] =
+{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+
+// Returns all the moves produced by the generator, in order
+MoveList drain(StagedMoveGenerator & generator)
+{
+    MoveList moves;
+    Move     move;
+    while (generator.next(move))
+        moves.push_back(move);
+    return moves;
+}
+
+bool contains(MoveList const & moves, Move const & move)
+{
+    return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+} // anonymous namespace
+
+TEST(StagedMoveGeneratorTest, SameMovesAsLegalGenerator)
+{
+    for (auto fen : FENS)
+    {
+        GameState state;
+        ASSERT_TRUE(state.initializeFromFen(fen)) << fen;
+
+        MoveList legal;
+        MoveGenerator::generateLegalMoves(state, legal);
+
+        // Use a quiet move as a killer and the last move as the hash move
+        Move const * hashMove = legal.empty() ? nullptr : &legal.back();
+        MoveList     quiets;
+        MoveGenerator::generateLegalMoves(state, quiets, MoveGenerator::QUIETS);
+
+        StagedMoveGenerator generator(state, hashMove, quiets.begin(), std::min<int>((int)quiets.size(), 2));
+        MoveList            staged = drain(generator);
+
+        EXPECT_EQ(staged.size(), legal.size()) << fen;
+        for (auto const & move : legal)
+            EXPECT_EQ(std::count(staged.begin(), staged.end(), move), 1) << fen << " " << move.notation(Notation::LONG);
+    }
+}
+
+TEST(StagedMoveGeneratorTest, Order)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+
+    Piece const * whiteKnight = Piece::get(PieceTypeId::KNIGHT, Color::WHITE);
+    Piece const * whitePawn   = Piece::get(PieceTypeId::PAWN, Color::WHITE);
+    Move          hashMove(Piece::get(PieceTypeId::QUEEN, Color::WHITE), Position(5, 5), Position(4, 5), NO_PIECE);   // Qf3-f4
+    Move          killers[] =
+    {
+        Move(whitePawn, Position(6, 0), Position(5, 0), NO_PIECE),                                                   // a2-a3
+        Move(whiteKnight, Position(3, 4), Position(1, 5), state.board_.pieceAt(1, 5)),                               // Ne5xf7 (a capture, ignored)
+    };
+
+    StagedMoveGenerator generator(state, &hashMove, killers, 2);
+    MoveList            moves = drain(generator);
+    ASSERT_FALSE(moves.empty());
+
+    // The hash move is first
+    EXPECT_EQ(moves[0], hashMove);
+
+    // Then the captures in MVV/LVA order
+    size_t i = 1;
+    int    previous = INT_MAX;
+    for (; i < moves.size() && (moves[i].isCapture() || moves[i].isPromotion()); ++i)
+    {
+        int score = StagedMoveGenerator::mvvLva(state, moves[i]);
+        EXPECT_LE(score, previous) << moves[i].notation(Notation::LONG);
+        previous = score;
+    }
+    EXPECT_GT(i, 1u);
+
+    // Then the quiet killer, and then the rest of the quiet moves
+    ASSERT_LT(i, moves.size());
+    EXPECT_EQ(moves[i], killers[0]);
+    for (++i; i < moves.size(); ++i)
+        EXPECT_FALSE(moves[i].isCapture() || moves[i].isPromotion()) << moves[i].notation(Notation::LONG);
+    EXPECT_EQ(std::count(moves.begin(), moves.end(), killers[1]), 1);
+}
+
+TEST(StagedMoveGeneratorTest, IllegalHashMoveAndKillers)
+{
+    GameState state;
+    state.initialize();
+
+    // Neither move is legal in the initial position
+    Move hashMove(Piece::get(PieceTypeId::QUEEN, Color::WHITE), Position(7, 3), Position(3, 3), NO_PIECE);
+    Move killer(Piece::get(PieceTypeId::KNIGHT, Color::BLACK), Position(0, 1), Position(2, 2), NO_PIECE);
+
+    StagedMoveGenerator generator(state, &hashMove, &killer, 1);
+    MoveList            moves = drain(generator);
+    EXPECT_EQ(moves.size(), 20u);
+    EXPECT_FALSE(contains(moves, hashMove));
+    EXPECT_FALSE(contains(moves, killer));
+}
+
+TEST(StagedMoveGeneratorTest, LosingCapturesLast)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1"));
+
+    // Qxd5 loses the queen to the pawn on c6, so with the ordering tables it comes after the quiet moves
+    Move qxp(Piece::get(PieceTypeId::QUEEN, Color::WHITE), Position(7, 3), Position(3, 3), state.board_.pieceAt(3, 3));
+
+    MoveOrdering        ordering;
+    StagedMoveGenerator ordered(state, nullptr, nullptr, 0, &ordering);
+    MoveList            moves = drain(ordered);
+    ASSERT_FALSE(moves.empty());
+    EXPECT_EQ(moves[moves.size() - 1], qxp);
+
+    MoveList legal;
+    MoveGenerator::generateLegalMoves(state, legal);
+    EXPECT_EQ(moves.size(), legal.size());
+
+    // Without them, captures come first
+    StagedMoveGenerator unordered(state);
+    moves = drain(unordered);
+    ASSERT_FALSE(moves.empty());
+    EXPECT_EQ(moves[0], qxp);
+}
+
+TEST(StagedMoveGeneratorTest, MvvLva)
+{
+    GameState state;
+    ASSERT_TRUE(state.initializeFromFen("4k3/8/8/3q4/2P1N3/8/8/4K3 w - - 0 1"));
+
+    Move pxq(Piece::get(PieceTypeId::PAWN, Color::WHITE), Position(4, 2), Position(3, 3), state.board_.pieceAt(3, 3));
+    Move nxq(Piece::get(PieceTypeId::KNIGHT, Color::WHITE), Position(4, 4), Position(3, 3), state.board_.pieceAt(3, 3));
+    EXPECT_GT(StagedMoveGenerator::mvvLva(state, pxq), StagedMoveGenerator::mvvLva(state, nxq));
+}
@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/Piece.h"
+#include "Chess/Position.h"
+#include "Chess/StaticEvaluator.h"
+#include "Chess/Types.h"
+
+namespace
+{
+// Returns the static exchange value of a capture in the position
+int see(char const * fen, Move const & move)
+{
+    GameState state;
+    EXPECT_TRUE(state.initializeFromFen(fen)) << fen;
+    return StaticEvaluator::see(state, move);
+}
+
+Move capture(PieceTypeId type, Color color, Position from, Position to)
+{
+    return Move(Piece::get(type, color), from, to, true);
+}
+} // anonymous namespace
+
+TEST(StaticEvaluatorTest, SeeCaptures)
+{
+    Move queenTakesPawn = capture(PieceTypeId::QUEEN, Color::WHITE, Position(7, 3), Position(3, 3));
+    Move rookTakesPawn  = capture(PieceTypeId::ROOK, Color::WHITE, Position(6, 3), Position(3, 3));
+
+    // Undefended and defended victims
+    EXPECT_EQ(see("4k3/8/8/3p4/8/8/8/3QK3 w - - 0 1", queenTakesPawn), 100);
+    EXPECT_EQ(see("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1", queenTakesPawn), -800);
+
+    // The rook behind the rook that captures joins the exchange (x-ray)
+    EXPECT_EQ(see("3rk3/8/8/3p4/8/8/3R4/4K3 w - - 0 1", rookTakesPawn), -400);
+    EXPECT_EQ(see("3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1", rookTakesPawn), 100);
+
+    // The king can only recapture if the square is not defended
+    Move rookTakesKingsPawn = capture(PieceTypeId::ROOK, Color::WHITE, Position(7, 3), Position(4, 3));
+    EXPECT_EQ(see("8/8/8/3k4/3p4/8/8/3RK3 w - - 0 1", rookTakesKingsPawn), -400);
+    EXPECT_EQ(see("8/8/8/3k4/3p4/8/5B2/3RK3 w - - 0 1", rookTakesKingsPawn), 100);
+}
+
+TEST(StaticEvaluatorTest, SeeSpecialMoves)
+{
+    // En passant
+    EXPECT_EQ(see("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", Move::enPassant(Color::WHITE, Position(3, 4), Position(2, 3))), 100);
+
+    // Promotions, with and without a capture, gain the value of the queen less the pawn
+    EXPECT_EQ(see("4k3/P7/8/8/8/8/8/4K3 w - - 0 1", Move::promotion(Color::WHITE, Position(1, 0), Position(0, 0))), 800);
+    EXPECT_EQ(see("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1", Move::promotion(Color::WHITE, Position(1, 0), Position(0, 0))), -100);
+    EXPECT_EQ(see("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1", Move::promotion(Color::WHITE, Position(1, 0), Position(0, 1), true)),
+              1300);
+}
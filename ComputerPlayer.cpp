@@ -1,5 +1,6 @@
 #include "ComputerPlayer.h"
 
+#include "BitBoard/BitBoard.h"
 #include "Chess/Board.h"
 #include "Chess/GameState.h"
 #include "Chess/ResponseGenerator.h"
@@ -9,59 +10,294 @@
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <ctime>
+#include <mutex>
+#include <thread>
 
 using json = nlohmann::json;
 
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// When playing on a clock, the remaining time is divided as if this many moves are left to play
+int constexpr MOVES_TO_GO = 30;
+
+// Time kept in reserve on the clock for overhead outside of the search (ms)
+int constexpr SAFETY_MARGIN = 50;
+
+// Number of entries in each GameTree thread's transposition table
+size_t constexpr TRANSPOSITION_TABLE_SIZE = 1 << 19;
+
+// Sets the abort flag if the deadline passes before the monitor is destroyed
+class DeadlineMonitor
+{
+public:
+    DeadlineMonitor(Clock::time_point deadline, std::atomic<bool> & abort)
+        : thread_([this, deadline, &abort] {
+                      std::unique_lock<std::mutex> lock(mutex_);
+                      if (!done_.wait_until(lock, deadline, [this] { return finished_; }))
+                          abort = true;
+                  })
+    {
+    }
+
+    ~DeadlineMonitor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finished_ = true;
+        }
+        done_.notify_one();
+        thread_.join();
+    }
+
+private:
+    std::mutex              mutex_;
+    std::condition_variable done_;
+    bool                    finished_ = false;
+    std::thread             thread_;    // Must be last since it uses the other members
+};
+
+int milliseconds(Clock::duration d)
+{
+    return (int)std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+} // anonymous namespace
+
 ComputerPlayer::ComputerPlayer(Color color, int maxDepth)
+    : ComputerPlayer(color, maxDepth, TimeControl())
+{
+}
+
+ComputerPlayer::ComputerPlayer(Color                      color,
+                               int                        maxDepth,
+                               TimeControl const &        timeControl,
+                               int                        threads /*= 1*/,
+                               Engine                     engine /*= Engine::GAME_TREE*/,
+                               AlphaBeta::Options const * options /*= nullptr*/)
     : Player(color)
     , maxDepth_(maxDepth)
-    , transpositionTable_(new GamePlayer::TranspositionTable(1<<19, 1))
+    , timeControl_(timeControl)
+    , threads_((threads > 0) ? threads : std::max(1, (int)std::thread::hardware_concurrency()))
     , staticEvaluator_(new StaticEvaluator)
 {
+    // GamePlayer::TranspositionTable is not thread-safe, so each GameTree thread has its own
+    if (engine == Engine::YBWC)
+    {
+        if (options)
+            alphaBeta_.reset(new AlphaBeta(staticEvaluator_, threads_, 2, *options));
+        else
+            alphaBeta_.reset(new AlphaBeta(staticEvaluator_, threads_, 2));
+    }
+    else
+    {
+        for (int id = 0; id < threads_; ++id)
+        {
+            transpositionTables_.emplace_back(new GamePlayer::TranspositionTable(TRANSPOSITION_TABLE_SIZE, 1));
+        }
+    }
 }
 
+struct ComputerPlayer::Search
+{
+    Clock::time_point     start;
+    int                   budget;       // Time budget in ms, or 0 if there is no limit
+    std::atomic<bool>     abort{ false };
+    std::vector<uint64_t> nodes;        // Number of nodes generated by each thread
+
+    std::mutex                 mutex;       // Guards the members below
+    int                        depth = 0;   // Depth of the deepest completed iteration
+    std::shared_ptr<GameState> response;    // Response found by the deepest completed iteration
+    std::vector<int>           timeToDepth; // Time at which each depth was first completed, in ms
+};
+
 GameState ComputerPlayer::myTurn(GameState const & s0)
 {
 #if defined(ANALYSIS_PLAYER)
     time_t startTime = time(nullptr);
+    analysisData_.reset();
 #endif
 
-    // Calculate the best move from here
+    if (alphaBeta_)
+        alphaBeta_->resetStatistics();
+
+    Search search;
+    search.start  = Clock::now();
+    search.budget = allocateTime();
+    search.nodes.resize(threads_, 0);
+
+    // The monitor aborts the search when the time runs out
+    std::unique_ptr<DeadlineMonitor> monitor;
+    if (search.budget > 0)
+        monitor.reset(new DeadlineMonitor(search.start + std::chrono::milliseconds(search.budget), search.abort));
 
-    std::shared_ptr<GamePlayer::GameState> copy(new GameState(s0));
-    GamePlayer::GameTree tree(transpositionTable_, staticEvaluator_, ResponseGenerator(), maxDepth_);
-    tree.findBestResponse(copy);
-    std::shared_ptr<GameState> response = std::static_pointer_cast<GameState>(copy->response_);
-    transpositionTable_->age();
+    // With GameTree, the helper threads search the same tree as the main thread, each with its own transposition table.
+    // A helper contributes when it completes a deeper iteration than the main thread. AlphaBeta runs its own threads,
+    // which share their hash moves through a lock-free table.
+    std::vector<std::thread> helpers;
+    for (int id = 1; id < threads_ && !alphaBeta_; ++id)
+    {
+        helpers.emplace_back([this, &s0, id, &search] { searchIteratively(s0, id, search); });
+    }
+    searchIteratively(s0, 0, search);
+
+    // When the main thread is done, so are the helpers
+    search.abort = true;
+    for (auto & helper : helpers)
+    {
+        helper.join();
+    }
+    monitor.reset();
+    for (auto & table : transpositionTables_)
+    {
+        table->age();
+    }
 
 #if defined(ANALYSIS_PLAYER)
 
     // Update analysis data
 
-    analysisData_.elapsedTime = (int)(time(nullptr) - startTime);
-#if defined(ANALYSIS_GAME_TREE)
-    analysisData_.gameTreeAnalysisData = tree.analysisData_;
-    tree.analysisData_.reset();
-#endif
+    analysisData_.elapsedTime    = (int)(time(nullptr) - startTime);
+    analysisData_.completedDepth = search.depth;
+    analysisData_.timeToDepth    = search.timeToDepth;
+    analysisData_.threads        = threads_;
+    for (uint64_t n : search.nodes)
+    {
+        analysisData_.nodes += n;
+    }
+    if (alphaBeta_)
+    {
+        analysisData_.alphaBetaStatistics = alphaBeta_->statistics();
+        analysisData_.nodes               = alphaBeta_->statistics().nodes;
+        analysisData_.qnodes              = alphaBeta_->statistics().qnodes;
+    }
+    int elapsed = milliseconds(Clock::now() - search.start);
+    analysisData_.nps = (analysisData_.nodes + analysisData_.qnodes) * 1000 / std::max(elapsed, 1);
 #if defined(ANALYSIS_TRANSPOSITION_TABLE)
-    analysisData_.ttAnalysisData = transpositionTable_->analysisData_;
+    if (!transpositionTables_.empty())
+        analysisData_.ttAnalysisData = transpositionTables_[0]->analysisData_;
 #endif
 #endif // defined(ANALYSIS_PLAYER)
 
-    return *response;
+    return *search.response;
+}
+
+void ComputerPlayer::searchIteratively(GameState const & s0, int id, Search & search)
+{
+    // Search iteratively deeper. Each iteration leaves its results in the thread's transposition table, which gives the
+    // next iteration better move ordering and cutoffs. Odd-numbered helpers start one ply deeper, so that the threads are
+    // spread over two depths, and all helpers shuffle their moves, so that they don't duplicate the main thread's work.
+    for (int depth = 1 + (id & 1); depth <= maxDepth_; ++depth)
+    {
+#if defined(ANALYSIS_PLAYER)
+        Clock::time_point iterationStart = Clock::now();
+#endif
+
+        // The first iteration of the main thread is never aborted, so there is always a response
+        bool                       abortable = id > 0 || depth > 1;
+        std::shared_ptr<GameState> response;
+        if (alphaBeta_)
+        {
+            response = alphaBeta_->search(s0, depth, abortable ? &search.abort : nullptr);
+        }
+        else
+        {
+            std::shared_ptr<GamePlayer::GameState> copy(new GameState(s0));
+            ResponseGenerator    responseGenerator(abortable ? &search.abort : nullptr, &search.nodes[id], id);
+            GamePlayer::GameTree tree(transpositionTables_[id], staticEvaluator_, responseGenerator, depth);
+            tree.findBestResponse(copy);
+            response = std::static_pointer_cast<GameState>(copy->response_);
+#if defined(ANALYSIS_PLAYER) && defined(ANALYSIS_GAME_TREE)
+            if (id == 0)
+            {
+                analysisData_.gameTreeAnalysisData = tree.analysisData_;
+                tree.analysisData_.reset();
+            }
+#endif
+        }
+        if (search.abort && abortable)
+        {
+            // The nodes of an aborted iteration are valued as leaves, so its entries in the transposition table would
+            // poison the next search. GameTree can't tell them apart from the others, so the whole table is replaced.
+            // AlphaBeta doesn't keep the results of an aborted search.
+            if (!alphaBeta_)
+                transpositionTables_[id].reset(new GamePlayer::TranspositionTable(TRANSPOSITION_TABLE_SIZE, 1));
+#if defined(ANALYSIS_PLAYER)
+            if (id == 0)
+                analysisData_.aborted = true;
+#endif
+            break;
+        }
+
+        // Keep the response if it is from the deepest iteration completed so far
+        {
+            std::lock_guard<std::mutex> lock(search.mutex);
+            if (depth > search.depth)
+            {
+                search.depth    = depth;
+                search.response = response;
+                search.timeToDepth.resize(depth, milliseconds(Clock::now() - search.start));
+            }
+        }
+
+        if (id != 0)
+            continue;
+
+#if defined(ANALYSIS_PLAYER)
+        analysisData_.iterationTimes.push_back(milliseconds(Clock::now() - iterationStart));
+#endif
+
+        // Each iteration takes several times longer than the one before, so if half of the budget is gone, the next
+        // iteration won't finish and is not started.
+        if (search.budget > 0 && milliseconds(Clock::now() - search.start) * 2 > search.budget)
+            break;
+    }
+}
+
+int ComputerPlayer::allocateTime() const
+{
+    if (timeControl_.moveTime > 0)
+        return timeControl_.moveTime;
+
+    int remaining = timeControl_.remaining[(int)myColor_];
+    if (remaining <= 0)
+        return 0;
+
+    // Spend an even share of the remaining time plus most of the increment, but never more than is on the clock
+    int budget = remaining / MOVES_TO_GO + timeControl_.increment * 3 / 4;
+    return std::max(1, std::min(budget, remaining - SAFETY_MARGIN));
 }
 
 #if defined(ANALYSIS_PLAYER)
 
 ComputerPlayer::AnalysisData::AnalysisData()
     : elapsedTime(0)
+    , completedDepth(0)
+    , aborted(false)
+    , threads(0)
+    , nodes(0)
+    , qnodes(0)
+    , nps(0)
 {
 }
 
 void ComputerPlayer::AnalysisData::reset()
 {
-    elapsedTime = 0;
+    elapsedTime    = 0;
+    completedDepth = 0;
+    iterationTimes.clear();
+    timeToDepth.clear();
+    aborted = false;
+    threads = 0;
+    nodes   = 0;
+    qnodes  = 0;
+    nps     = 0;
+    alphaBetaStatistics = AlphaBeta::Statistics();
 #if defined(ANALYSIS_GAME_TREE)
     gameTreeAnalysisData.reset();
 #endif
@@ -72,9 +308,40 @@ void ComputerPlayer::AnalysisData::reset()
 
 nlohmann::json ComputerPlayer::AnalysisData::toJson() const
 {
+    // The fraction of the cutoffs caused by the first move searched is a measure of the quality of the move ordering
+    double firstMoveCutoffRate = (alphaBetaStatistics.cutoffs > 0)
+                                     ? double(alphaBetaStatistics.firstMoveCutoffs) / double(alphaBetaStatistics.cutoffs)
+                                     : 0.0;
+
     json out =
     {
-        { "elapsedTime", elapsedTime }
+        { "elapsedTime", elapsedTime },
+        { "completedDepth", completedDepth },
+        { "iterationTimes", iterationTimes },
+        { "timeToDepth", timeToDepth },
+        { "aborted", aborted },
+        { "threads", threads },
+        { "nodes", nodes },
+        { "qnodes", qnodes },
+        { "nps", nps },
+        { "alphaBeta",
+          {
+              { "splits", alphaBetaStatistics.splits },
+              { "tasks", alphaBetaStatistics.tasks },
+              { "steals", alphaBetaStatistics.steals },
+              { "abandoned", alphaBetaStatistics.abandoned },
+              { "splitCutoffs", alphaBetaStatistics.splitCutoffs },
+              { "nullMoveCutoffs", alphaBetaStatistics.nullMoveCutoffs },
+              { "failedVerifications", alphaBetaStatistics.failedVerifications },
+              { "reductions", alphaBetaStatistics.reductions },
+              { "researches", alphaBetaStatistics.researches },
+              { "cutoffs", alphaBetaStatistics.cutoffs },
+              { "firstMoveCutoffs", alphaBetaStatistics.firstMoveCutoffs },
+              { "firstMoveCutoffRate", firstMoveCutoffRate },
+              { "seePrunes", alphaBetaStatistics.seePrunes }
+          }
+        },
+        { "slidingAttackBackend", BitBoard::name(BitBoard::slidingAttackBackend()) }
 #if defined(ANALYSIS_GAME_TREE)
         , { "gameTree", gameTreeAnalysisData.toJson() }
 #endif
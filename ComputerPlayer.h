@@ -4,7 +4,10 @@
 #define COMPUTERPLAYER_H
 
 #include "Player.h"
+#include "Chess/AlphaBeta.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #if defined(ANALYSIS_GAME_TREE)
 #include "GamePlayer/GameTree.h"
@@ -25,7 +28,31 @@ class ComputerPlayer : public Player
 {
 public:
 
+    // Limits on the time spent searching for a move. All times are in milliseconds and 0 means not used.
+    struct TimeControl
+    {
+        int moveTime     = 0;        // Time to spend on each move (overrides the clocks)
+        int remaining[2] = { 0, 0 }; // Time left on each player's clock, indexed by Color
+        int increment    = 0;        // Time added to the clock after each move
+    };
+
+    // The search algorithms
+    enum class Engine
+    {
+        GAME_TREE,  // GamePlayer::GameTree, with threads searching the same root at different depths (Lazy SMP)
+        YBWC        // AlphaBeta, with threads splitting the tree (Young Brothers Wait)
+    };
+
+    // If threads is 0, the number of hardware threads is used. The selective search options only apply to YBWC. If they
+    // are null, AlphaBeta's defaults are used, which turn off the selective search with more than one thread so that
+    // the results don't depend on the number of threads.
     ComputerPlayer(Color color, int maxDepth);
+    ComputerPlayer(Color                      color,
+                   int                        maxDepth,
+                   TimeControl const &        timeControl,
+                   int                        threads = 1,
+                   Engine                     engine  = Engine::GAME_TREE,
+                   AlphaBeta::Options const * options = nullptr);
     virtual ~ComputerPlayer() = default;
 
     virtual GameState myTurn(GameState const & s0) override;
@@ -34,7 +61,16 @@ public:
 
     struct AnalysisData
     {
-        int elapsedTime;
+        int                   elapsedTime;
+        int                   completedDepth;      // Depth of the deepest iteration completed by any thread
+        std::vector<int>      iterationTimes;      // Time spent on each completed iteration by the main thread, in ms
+        std::vector<int>      timeToDepth;         // Time at which each depth was first completed by any thread, in ms
+        bool                  aborted;             // True if an iteration was aborted at the deadline
+        int                   threads;             // Number of threads searching
+        uint64_t              nodes;               // Number of nodes generated by all threads
+        uint64_t              qnodes;              // Number of nodes searched by the quiescence search (YBWC only)
+        uint64_t              nps;                 // Nodes (including qnodes) per second
+        AlphaBeta::Statistics alphaBetaStatistics; // Work done by the YBWC engine
 #if defined(ANALYSIS_GAME_TREE)
         GamePlayer::GameTree::AnalysisData gameTreeAnalysisData;
 #endif
@@ -51,8 +87,20 @@ public:
 
 private:
 
+    // The state of a move's search shared by all threads
+    struct Search;
+
+    // Searches iteratively deeper until the search is done or aborted. The thread with id 0 is the main thread.
+    void searchIteratively(GameState const & s0, int id, Search & search);
+
+    // Returns the time budget for a move in milliseconds, or 0 if there is no limit
+    int allocateTime() const;
+
     int maxDepth_;
-    std::shared_ptr<GamePlayer::TranspositionTable> transpositionTable_;
+    TimeControl timeControl_;
+    int threads_;
+    std::unique_ptr<AlphaBeta> alphaBeta_;      // The YBWC engine, or null if GameTree is used
+    std::vector<std::shared_ptr<GamePlayer::TranspositionTable>> transpositionTables_; // One per GameTree thread
     std::shared_ptr<StaticEvaluator> staticEvaluator_;
 };
 
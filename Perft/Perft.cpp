@@ -0,0 +1,207 @@
+#include "Perft.h"
+
+#include "Chess/MoveGenerator.h"
+#include "Chess/MoveList.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+// The top of the tree is expanded until there are at least this many subtrees per thread, so that the threads stay
+// busy even though the sizes of the subtrees vary a lot.
+size_t constexpr TASKS_PER_THREAD = 16;
+} // anonymous namespace
+
+Perft::Perft(size_t hashSize /*= 0*/, unsigned threads /*= 1*/)
+    : threads_((threads > 0) ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{
+    // The number of entries is rounded down to a power of 2 so that the index is a mask of the hash
+    size_t n = hashSize / sizeof(Entry);
+    if (n > 0)
+    {
+        size_ = 1;
+        while (size_ * 2 <= n)
+            size_ *= 2;
+        table_.reset(new Entry[size_]);
+        for (size_t i = 0; i < size_; ++i)
+        {
+            table_[i].check.store(0, std::memory_order_relaxed);
+            table_[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t Perft::count(GameState const & state, int depth)
+{
+    if (depth == 0)
+        return 1;
+
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(state, moves);
+    if (depth == 1)
+        return moves.size();
+
+    std::vector<uint64_t> counts = countRootMoves(state, moves, depth - 1);
+    uint64_t              nodes  = 0;
+    for (auto n : counts)
+        nodes += n;
+    return nodes;
+}
+
+std::vector<Perft::Division> Perft::divide(GameState const & state, int depth)
+{
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(state, moves);
+
+    std::vector<uint64_t> counts;
+    if (depth > 1)
+        counts = countRootMoves(state, moves, depth - 1);
+    else
+        counts.assign(moves.size(), 1);
+
+    std::vector<Division> divisions;
+    divisions.reserve(moves.size());
+    for (size_t i = 0; i < moves.size(); ++i)
+    {
+        divisions.push_back(Division{ moves[i], counts[i] });
+    }
+    return divisions;
+}
+
+uint64_t Perft::count(GameState & state, int depth, uint64_t & hits)
+{
+    if (depth == 0)
+        return 1;
+
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(state, moves);
+
+    // The leaves are not visited, since their number is the number of legal moves
+    if (depth == 1)
+        return moves.size();
+
+    ZHash::Z key = state.zhash_.value();
+    uint64_t nodes;
+    if (probe(key, depth, nodes))
+    {
+        ++hits;
+        return nodes;
+    }
+
+    nodes = 0;
+    for (auto const & move : moves)
+    {
+        GameState::UndoInfo undo;
+        state.makeMove(move, undo);
+        nodes += count(state, depth - 1, hits);
+        state.unmakeMove(move, undo);
+    }
+
+    store(key, depth, nodes);
+    return nodes;
+}
+
+// Returns the number of leaf nodes at the given depth below each of the moves
+std::vector<uint64_t> Perft::countRootMoves(GameState const & state, MoveList const & moves, int depth)
+{
+    std::vector<uint64_t> counts(moves.size(), 0);
+
+    // The states after the moves at the root are the initial subtrees
+    std::vector<Task> tasks;
+    tasks.reserve(moves.size());
+    for (size_t i = 0; i < moves.size(); ++i)
+    {
+        Task task{ state, depth, i };
+        GameState::UndoInfo undo;
+        task.state.makeMove(moves[i], undo);
+        tasks.push_back(task);
+    }
+
+    // Split each subtree into the subtrees of its moves until there are enough for the threads. Subtrees of depth 1
+    // are not split, since they are counted without visiting their leaves.
+    if (threads_ > 1)
+    {
+        while (tasks.size() < threads_ * TASKS_PER_THREAD && depth > 1)
+        {
+            std::vector<Task> split;
+            for (auto & task : tasks)
+            {
+                MoveList children;
+                MoveGenerator::generateLegalMoves(task.state, children);
+                for (auto const & move : children)
+                {
+                    Task child{ task.state, depth - 1, task.root };
+                    GameState::UndoInfo undo;
+                    child.state.makeMove(move, undo);
+                    split.push_back(child);
+                }
+            }
+            tasks.swap(split);
+            --depth;
+        }
+    }
+
+    // Each thread takes the next subtree until there are none left and adds its count to the count of the root move
+    std::vector<std::atomic<uint64_t>> totals(moves.size());
+    for (auto & t : totals)
+        t.store(0, std::memory_order_relaxed);
+    std::atomic<size_t>   next(0);
+    std::atomic<uint64_t> hits(0);
+
+    auto work = [&]() {
+        uint64_t localHits = 0;
+        for (size_t i = next.fetch_add(1); i < tasks.size(); i = next.fetch_add(1))
+        {
+            Task & task = tasks[i];
+            totals[task.root].fetch_add(count(task.state, task.depth, localHits), std::memory_order_relaxed);
+        }
+        hits.fetch_add(localHits, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> pool;
+    unsigned                 n = std::min<size_t>(threads_, tasks.size());
+    for (unsigned i = 1; i < n; ++i)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto & thread : pool)
+    {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        counts[i] = totals[i].load();
+    }
+    hits_ += hits.load();
+    return counts;
+}
+
+bool Perft::probe(ZHash::Z key, int depth, uint64_t & nodes) const
+{
+    if (size_ == 0)
+        return false;
+
+    Entry const & entry = table_[key & (size_ - 1)];
+    uint64_t      data  = entry.data.load(std::memory_order_relaxed);
+    uint64_t      check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key || int(data & ((1 << DEPTH_BITS) - 1)) != depth)
+        return false;
+
+    nodes = data >> DEPTH_BITS;
+    return true;
+}
+
+void Perft::store(ZHash::Z key, int depth, uint64_t nodes)
+{
+    if (size_ == 0)
+        return;
+
+    // Always replace
+    Entry &  entry = table_[key & (size_ - 1)];
+    uint64_t data  = (nodes << DEPTH_BITS) | uint64_t(depth);
+    entry.check.store(key ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
@@ -0,0 +1,80 @@
+#if !defined(PERFT_PERFT_H)
+#define PERFT_PERFT_H
+
+#pragma once
+
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/MoveList.h"
+#include "Chess/ZHash.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Counts the leaf nodes of the tree of legal moves to a given depth (perft).
+//
+// The counts of well-known positions are published, so perft validates move generation, make and unmake. It also
+// times them, since nothing else is done at each node. Counts of subtrees can optionally be cached in a table keyed by
+// the Zobrist hash of the position, which makes deep counts much faster because of transpositions.
+//
+// With more than one thread, the top of the tree is expanded into independent subtrees, which a pool of threads
+// counts. The threads share the cache, which is lock-free.
+class Perft
+{
+public:
+    // The number of nodes under one of the moves at the root
+    struct Division
+    {
+        Move     move;
+        uint64_t nodes;
+    };
+
+    // Constructor. If hashSize is not 0, a cache of approximately that many bytes is used. If threads is 0, the
+    // number of hardware threads is used.
+    explicit Perft(size_t hashSize = 0, unsigned threads = 1);
+
+    // Returns the number of leaf nodes at the given depth below the state
+    uint64_t count(GameState const & state, int depth);
+
+    // Returns the number of leaf nodes at the given depth below each move of the state
+    std::vector<Division> divide(GameState const & state, int depth);
+
+    // Returns the number of threads used
+    unsigned threads() const { return threads_; }
+
+    // Returns the number of times a count was found in the cache
+    uint64_t hits() const { return hits_; }
+
+private:
+    // An entry is written and read without locking. The key is stored xor'ed with the data so that an entry that
+    // is torn by simultaneous writes doesn't match any key.
+    struct Entry
+    {
+        std::atomic<uint64_t> check;    // Hash of the position ^ data
+        std::atomic<uint64_t> data;     // Number of leaf nodes << DEPTH_BITS | depth
+    };
+
+    static int constexpr DEPTH_BITS = 8;
+
+    // A subtree counted by one of the threads
+    struct Task
+    {
+        GameState state;
+        int       depth;
+        size_t    root;     // Index of the move at the root that leads to this subtree
+    };
+
+    uint64_t count(GameState & state, int depth, uint64_t & hits);
+    std::vector<uint64_t> countRootMoves(GameState const & state, MoveList const & moves, int depth);
+    bool probe(ZHash::Z key, int depth, uint64_t & nodes) const;
+    void store(ZHash::Z key, int depth, uint64_t nodes);
+
+    std::unique_ptr<Entry[]> table_;
+    size_t                   size_ = 0;
+    unsigned                 threads_;
+    uint64_t                 hits_ = 0;
+};
+
+#endif // !defined(PERFT_PERFT_H)
@@ -0,0 +1,133 @@
+// Counts the leaf nodes of the tree of legal moves (perft) and reports the rate.
+//
+// usage: chess_perft [--depth=N] [--divide] [--hash=MB] [--threads=N] [--expect=N] [fen]
+//
+//      --depth=N       Depth of the tree (default 5)
+//      --divide        Also print the number of nodes under each move at the root
+//      --hash=MB       Cache subtree counts in a table of this size
+//      --threads=N     Number of threads (default 1, 0 means one per hardware thread)
+//      --expect=N      Exit with a failure status if the count is not N
+//      fen             The position (default is the initial position)
+
+#include "Perft.h"
+
+#include "Chess/GameState.h"
+#include "Chess/Move.h"
+#include "Chess/Types.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static constexpr char   OPTION_DEPTH_KEY[]         = "--depth=";
+static constexpr size_t OPTION_DEPTH_KEY_LENGTH    = sizeof(OPTION_DEPTH_KEY) - 1;
+static constexpr char   OPTION_DIVIDE_KEY[]        = "--divide";
+static constexpr char   OPTION_HASH_KEY[]          = "--hash=";
+static constexpr size_t OPTION_HASH_KEY_LENGTH     = sizeof(OPTION_HASH_KEY) - 1;
+static constexpr char   OPTION_THREADS_KEY[]       = "--threads=";
+static constexpr size_t OPTION_THREADS_KEY_LENGTH  = sizeof(OPTION_THREADS_KEY) - 1;
+static constexpr char   OPTION_EXPECT_KEY[]        = "--expect=";
+static constexpr size_t OPTION_EXPECT_KEY_LENGTH   = sizeof(OPTION_EXPECT_KEY) - 1;
+
+static int                depth    = 5;
+static bool               divide   = false;
+static size_t             hashSize = 0;
+static unsigned           threads  = 1;
+static unsigned long long expected = 0;
+static bool               checked  = false;
+
+// Returns a move in coordinate notation (the from and to squares, and the promotion if any, e.g. "e1g1" or "a7a8q"),
+// which is how other perft tools print their divide lines
+static std::string coordinates(Move const & move)
+{
+    static char const PROMOTIONS[] = "kqbnrp"; // Indexed by PieceTypeId
+
+    std::string text = move.from().notation() + move.to().notation();
+    if (move.isPromotion())
+        text += PROMOTIONS[(int)move.promotedTo()];
+    return text;
+}
+
+int main(int argc, char ** argv)
+{
+    GameState state;
+    state.initialize();
+
+    --argc;
+    ++argv;
+    while (argc > 0)
+    {
+        if (strncmp(*argv, OPTION_DEPTH_KEY, OPTION_DEPTH_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_DEPTH_KEY_LENGTH, "%d", &depth);
+        }
+        else if (strcmp(*argv, OPTION_DIVIDE_KEY) == 0)
+        {
+            divide = true;
+        }
+        else if (strncmp(*argv, OPTION_HASH_KEY, OPTION_HASH_KEY_LENGTH) == 0)
+        {
+            unsigned megabytes = 0;
+            sscanf(*argv + OPTION_HASH_KEY_LENGTH, "%u", &megabytes);
+            hashSize = size_t(megabytes) * 1024 * 1024;
+        }
+        else if (strncmp(*argv, OPTION_THREADS_KEY, OPTION_THREADS_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_THREADS_KEY_LENGTH, "%u", &threads);
+        }
+        else if (strncmp(*argv, OPTION_EXPECT_KEY, OPTION_EXPECT_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_EXPECT_KEY_LENGTH, "%llu", &expected);
+            checked = true;
+        }
+        else if (!state.initializeFromFen(*argv))
+        {
+            fprintf(stderr, "Unable to parse input: %s\n", *argv);
+            exit(1);
+        }
+        --argc;
+        ++argv;
+    }
+
+    if (depth < 1)
+    {
+        fprintf(stderr, "The depth must be at least 1\n");
+        exit(1);
+    }
+
+    Perft perft(hashSize, threads);
+    auto  start = std::chrono::steady_clock::now();
+
+    unsigned long long nodes = 0;
+    if (divide)
+    {
+        for (auto const & d : perft.divide(state, depth))
+        {
+            printf("%s: %llu\n", coordinates(d.move).c_str(), (unsigned long long)d.nodes);
+            nodes += d.nodes;
+        }
+        printf("\n");
+    }
+    else
+    {
+        nodes = perft.count(state, depth);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("Depth: %d\n", depth);
+    printf("Threads: %u\n", perft.threads());
+    printf("Nodes: %llu\n", nodes);
+    printf("Time: %.3f s\n", seconds);
+    printf("NPS: %.0f\n", (seconds > 0.0) ? double(nodes) / seconds : 0.0);
+    if (hashSize > 0)
+        printf("Hash hits: %llu\n", (unsigned long long)perft.hits());
+
+    if (checked && nodes != expected)
+    {
+        fprintf(stderr, "Expected %llu nodes, but counted %llu\n", expected, nodes);
+        return 1;
+    }
+    return 0;
+}
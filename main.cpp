@@ -1,3 +1,31 @@
+// Finds the computer's move in a position and prints it.
+//
+// usage: chess_player [options] [fen]
+//
+//      --notation=X            Notation of the move: standard, long, figurine, uci, iccf or pgn (default)
+//      --depth=N               Maximum depth of the search (default 7, or no maximum if there is a time limit)
+//      --movetime=MS           Time to spend on the move
+//      --wtime=MS, --btime=MS  Time left on each player's clock
+//      --inc=MS                Time added to the clock after each move
+//      --threads=N             Number of threads (default 1, 0 means one per hardware thread)
+//      --search=X              Search algorithm: gametree (default) or ybwc
+//
+// The YBWC search can be selective (null-move pruning and late move reductions), which reaches a greater depth in the
+// same time. The cost is that the threads prune and reduce differently depending on the bounds and history that each
+// one sees, so with more than one thread, the move and its value can vary from run to run and with the number of
+// threads. Without the selective search, they don't. So the selective search is on by default only with one thread.
+//
+//      --selective=on|off      Turns the selective search on or off regardless of the number of threads
+//      --null-move=N           Depth reduction of the null-move search (0 turns off null-move pruning)
+//      --null-move-depth=N     Minimum depth left for trying a null move
+//      --null-move-verify=N    Null-move cutoffs are verified with this many pieces or fewer
+//      --lmr=N                 Number of moves searched at full depth before reducing (0 turns off reductions)
+//      --lmr-depth=N           Minimum depth left for reducing a move
+//      --lmr-history=N         Moves with at least this history score are reduced less
+//
+// Giving any of the selective search options other than --selective=off turns it on. The ones not given keep their
+// defaults.
+
 #include "ComputerPlayer.h"
 
 #include "Chess/Board.h"
@@ -15,13 +43,47 @@ using json = nlohmann::json;
 static void drawBoard(Board const & b);
 #endif
 
-static constexpr char   OPTION_NOTATION_KEY[]      = "--notation=";
-static constexpr size_t OPTION_NOTATION_KEY_LENGTH = sizeof(OPTION_NOTATION_KEY) - 1;
-static constexpr char   OPTION_DEPTH_KEY[]         = "--depth=";
-static constexpr size_t OPTION_DEPTH_KEY_LENGTH    = sizeof(OPTION_DEPTH_KEY) - 1;
+static constexpr char   OPTION_NOTATION_KEY[]              = "--notation=";
+static constexpr size_t OPTION_NOTATION_KEY_LENGTH         = sizeof(OPTION_NOTATION_KEY) - 1;
+static constexpr char   OPTION_DEPTH_KEY[]                 = "--depth=";
+static constexpr size_t OPTION_DEPTH_KEY_LENGTH            = sizeof(OPTION_DEPTH_KEY) - 1;
+static constexpr char   OPTION_MOVETIME_KEY[]              = "--movetime=";
+static constexpr size_t OPTION_MOVETIME_KEY_LENGTH         = sizeof(OPTION_MOVETIME_KEY) - 1;
+static constexpr char   OPTION_WTIME_KEY[]                 = "--wtime=";
+static constexpr size_t OPTION_WTIME_KEY_LENGTH            = sizeof(OPTION_WTIME_KEY) - 1;
+static constexpr char   OPTION_BTIME_KEY[]                 = "--btime=";
+static constexpr size_t OPTION_BTIME_KEY_LENGTH            = sizeof(OPTION_BTIME_KEY) - 1;
+static constexpr char   OPTION_INC_KEY[]                   = "--inc=";
+static constexpr size_t OPTION_INC_KEY_LENGTH              = sizeof(OPTION_INC_KEY) - 1;
+static constexpr char   OPTION_THREADS_KEY[]               = "--threads=";
+static constexpr size_t OPTION_THREADS_KEY_LENGTH          = sizeof(OPTION_THREADS_KEY) - 1;
+static constexpr char   OPTION_SEARCH_KEY[]                = "--search=";
+static constexpr size_t OPTION_SEARCH_KEY_LENGTH           = sizeof(OPTION_SEARCH_KEY) - 1;
+static constexpr char   OPTION_SELECTIVE_KEY[]             = "--selective=";
+static constexpr size_t OPTION_SELECTIVE_KEY_LENGTH        = sizeof(OPTION_SELECTIVE_KEY) - 1;
+static constexpr char   OPTION_NULL_MOVE_KEY[]             = "--null-move=";
+static constexpr size_t OPTION_NULL_MOVE_KEY_LENGTH        = sizeof(OPTION_NULL_MOVE_KEY) - 1;
+static constexpr char   OPTION_NULL_MOVE_DEPTH_KEY[]       = "--null-move-depth=";
+static constexpr size_t OPTION_NULL_MOVE_DEPTH_KEY_LENGTH  = sizeof(OPTION_NULL_MOVE_DEPTH_KEY) - 1;
+static constexpr char   OPTION_NULL_MOVE_VERIFY_KEY[]      = "--null-move-verify=";
+static constexpr size_t OPTION_NULL_MOVE_VERIFY_KEY_LENGTH = sizeof(OPTION_NULL_MOVE_VERIFY_KEY) - 1;
+static constexpr char   OPTION_LMR_KEY[]                   = "--lmr=";
+static constexpr size_t OPTION_LMR_KEY_LENGTH              = sizeof(OPTION_LMR_KEY) - 1;
+static constexpr char   OPTION_LMR_DEPTH_KEY[]             = "--lmr-depth=";
+static constexpr size_t OPTION_LMR_DEPTH_KEY_LENGTH        = sizeof(OPTION_LMR_DEPTH_KEY) - 1;
+static constexpr char   OPTION_LMR_HISTORY_KEY[]           = "--lmr-history=";
+static constexpr size_t OPTION_LMR_HISTORY_KEY_LENGTH      = sizeof(OPTION_LMR_HISTORY_KEY) - 1;
+
+static constexpr int DEFAULT_DEPTH = 7;  // Search depth if there is no time limit
+static constexpr int MAX_DEPTH     = 64; // Search depth limit if there is a time limit
 
-static Notation notation = Notation::PGN;
-static int      depth    = 7;
+static Notation                    notation  = Notation::PGN;
+static int                         depth     = 0;
+static ComputerPlayer::TimeControl timeControl;
+static int                         threads   = 1;     // 0 means one per hardware thread
+static ComputerPlayer::Engine      engine    = ComputerPlayer::Engine::GAME_TREE;
+static AlphaBeta::Options          options;           // Selective search options (YBWC only)
+static bool                        selective = false; // True if the selective search options are given explicitly
 
 int main(int argc, char ** argv)
 {
@@ -52,6 +114,71 @@ int main(int argc, char ** argv)
         {
             sscanf(*argv + OPTION_DEPTH_KEY_LENGTH, "%d", &depth);
         }
+        else if (strncmp(*argv, OPTION_MOVETIME_KEY, OPTION_MOVETIME_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_MOVETIME_KEY_LENGTH, "%d", &timeControl.moveTime);
+        }
+        else if (strncmp(*argv, OPTION_WTIME_KEY, OPTION_WTIME_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_WTIME_KEY_LENGTH, "%d", &timeControl.remaining[(int)Color::WHITE]);
+        }
+        else if (strncmp(*argv, OPTION_BTIME_KEY, OPTION_BTIME_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_BTIME_KEY_LENGTH, "%d", &timeControl.remaining[(int)Color::BLACK]);
+        }
+        else if (strncmp(*argv, OPTION_INC_KEY, OPTION_INC_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_INC_KEY_LENGTH, "%d", &timeControl.increment);
+        }
+        else if (strncmp(*argv, OPTION_THREADS_KEY, OPTION_THREADS_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_THREADS_KEY_LENGTH, "%d", &threads);
+        }
+        else if (strncmp(*argv, OPTION_SEARCH_KEY, OPTION_SEARCH_KEY_LENGTH) == 0)
+        {
+            if (strcmp(*argv + OPTION_SEARCH_KEY_LENGTH, "ybwc") == 0)
+                engine = ComputerPlayer::Engine::YBWC;
+            else
+                engine = ComputerPlayer::Engine::GAME_TREE;
+        }
+        else if (strncmp(*argv, OPTION_SELECTIVE_KEY, OPTION_SELECTIVE_KEY_LENGTH) == 0)
+        {
+            if (strcmp(*argv + OPTION_SELECTIVE_KEY_LENGTH, "off") == 0)
+                options = AlphaBeta::Options::exact();
+            else
+                options = AlphaBeta::Options();
+            selective = true;
+        }
+        else if (strncmp(*argv, OPTION_NULL_MOVE_KEY, OPTION_NULL_MOVE_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_NULL_MOVE_KEY_LENGTH, "%d", &options.nullMoveReduction);
+            selective = true;
+        }
+        else if (strncmp(*argv, OPTION_NULL_MOVE_DEPTH_KEY, OPTION_NULL_MOVE_DEPTH_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_NULL_MOVE_DEPTH_KEY_LENGTH, "%d", &options.nullMoveMinDepth);
+            selective = true;
+        }
+        else if (strncmp(*argv, OPTION_NULL_MOVE_VERIFY_KEY, OPTION_NULL_MOVE_VERIFY_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_NULL_MOVE_VERIFY_KEY_LENGTH, "%d", &options.verifyPieces);
+            selective = true;
+        }
+        else if (strncmp(*argv, OPTION_LMR_KEY, OPTION_LMR_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_LMR_KEY_LENGTH, "%d", &options.lmrMinMoves);
+            selective = true;
+        }
+        else if (strncmp(*argv, OPTION_LMR_DEPTH_KEY, OPTION_LMR_DEPTH_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_LMR_DEPTH_KEY_LENGTH, "%d", &options.lmrMinDepth);
+            selective = true;
+        }
+        else if (strncmp(*argv, OPTION_LMR_HISTORY_KEY, OPTION_LMR_HISTORY_KEY_LENGTH) == 0)
+        {
+            sscanf(*argv + OPTION_LMR_HISTORY_KEY_LENGTH, "%d", &options.lmrHistory);
+            selective = true;
+        }
         else if (!s0.initializeFromFen(*argv))
         {
             fprintf(stderr, "Unable to parse input: %s\n", *argv);
@@ -65,7 +192,14 @@ int main(int argc, char ** argv)
     drawBoard(s0.board_);
 #endif
 
-    ComputerPlayer computer(s0.whoseTurn_, depth);
+    // Without a depth, the search is limited only by the time if there is a time limit
+    if (depth <= 0)
+    {
+        bool timed = timeControl.moveTime > 0 || timeControl.remaining[(int)s0.whoseTurn_] > 0;
+        depth = timed ? MAX_DEPTH : DEFAULT_DEPTH;
+    }
+
+    ComputerPlayer computer(s0.whoseTurn_, depth, timeControl, threads, engine, selective ? &options : nullptr);
     GameState      s1 = computer.myTurn(s0);
     printf("%s", s1.move_.notation(notation).c_str());
 